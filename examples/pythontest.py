@@ -63,7 +63,7 @@ class TestSASA(unittest.TestCase):
         for i in r:   #         loop over particle-particle distances
             spc.p[1].pos = [0,0,i]
             u.append( H.energy(c) )
-        np.testing.assert_almost_equal(u, [87.3576,100.4612,127.3487,138.4422,87.3576], 4)
+        np.testing.assert_almost_equal(u, [87.3576,100.4612,127.3487,138.4422,138.4422], 4)
 
 # Geometry
 
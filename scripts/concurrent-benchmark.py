@@ -0,0 +1,56 @@
+#!/usr/bin/env python
+
+import sys
+if sys.version_info < (3, 0):
+    sys.stdout.write("Sorry, Python 3 og higher required\n")
+    sys.exit(1)
+
+import os, json, argparse, shutil, subprocess, tempfile, time
+
+parser = argparse.ArgumentParser(
+    description='Compare run times of examples with and without concurrent evaluation of the trial and accepted energies')
+parser.add_argument('--faunus', default='faunus', help='faunus executable (default: faunus)')
+parser.add_argument('--repeat', default=3, type=int, help='number of runs for each setting (default: 3)')
+parser.add_argument('--micro', type=int, help='override number of micro steps')
+parser.add_argument('examples', nargs='+', help='example input (.yml/.json); a state file "name.state.json" is used if found')
+args = parser.parse_args()
+
+scriptdir = os.path.dirname(os.path.abspath(__file__))
+
+def load(filename):
+    ''' returns input as dictionary, converting yaml via `yason.py` '''
+    if filename.endswith('.json'):
+        with open(filename) as f:
+            return json.load(f)
+    out = subprocess.check_output([sys.executable, os.path.join(scriptdir, 'yason.py'), filename])
+    return json.loads(out)
+
+def run(inputdict, exampledir, state):
+    ''' run faunus on input in a temporary copy of `exampledir` and return wall time in seconds '''
+    with tempfile.TemporaryDirectory() as tmp:
+        workdir = os.path.join(tmp, 'run') # analysis output is discarded with the copy
+        shutil.copytree(exampledir, workdir)
+        inputfile = os.path.join(workdir, 'benchmark-input.json')
+        with open(inputfile, 'w') as f:
+            json.dump(inputdict, f)
+        cmd = [args.faunus, '--nobar', '--notips', '--quiet', '--input', inputfile, '--output', os.devnull]
+        if state:
+            cmd += ['--state', state]
+        start = time.perf_counter()
+        subprocess.check_call(cmd, cwd=workdir, stdout=subprocess.DEVNULL)
+        return time.perf_counter() - start
+
+print('{:30} {:>10} {:>10} {:>8}'.format('example', 'serial/s', 'conc./s', 'speedup'))
+for filename in args.examples:
+    exampledir = os.path.dirname(os.path.abspath(filename))
+    state = os.path.splitext(os.path.abspath(filename))[0] + '.state.json'
+    state = state if os.path.isfile(state) else None
+    serial = load(filename)
+    if args.micro:
+        serial['mcloop']['micro'] = args.micro
+    concurrent = json.loads(json.dumps(serial))
+    concurrent['energy'].append({'concurrent': True})
+
+    t1 = min(run(serial, exampledir, state) for i in range(args.repeat))
+    t2 = min(run(concurrent, exampledir, state) for i in range(args.repeat))
+    print('{:30} {:10.2f} {:10.2f} {:8.2f}'.format(os.path.basename(filename), t1, t2, t1 / t2))
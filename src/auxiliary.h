@@ -617,6 +617,12 @@ namespace Faunus
                     return m[i][j];
                 }
 
+                const T* row(size_t i) const {
+                    static_assert(not triangular, "rows are contiguous only for full matrices");
+                    assert(i < m.size());
+                    return m[i].data();
+                } //!< Pointer to contiguous row `i`, i.e. `m(i,j)` equals `row(i)[j]`
+
                 void set(size_t i, size_t j, T val) {
                     if (j>i)
                         std::swap(i, j);
@@ -2043,10 +2049,11 @@ namespace Faunus
 
                 void start() { tx = std::chrono::steady_clock::now(); }
 
-                void stop()
+                double stop() //!< Stop timer and return seconds since `start()`
                 {
-                    delta += std::chrono::duration_cast<Tunit>
-                        (std::chrono::steady_clock::now() - tx);
+                    auto lap = std::chrono::steady_clock::now() - tx;
+                    delta += std::chrono::duration_cast<Tunit>(lap);
+                    return std::chrono::duration<double>(lap).count();
                 }
 
                 double result() const
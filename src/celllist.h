@@ -2,115 +2,274 @@
 
 #include <iostream>
 #include <vector>
-#include <set>
 #include <cassert>
 #include <cmath>
 #include <array>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
 #include <Eigen/Core>
 
 namespace Faunus {
 
     /**
-     * @brief Cuboidal cell list with periodic boundaries
+     * @brief Cuboidal cell list with periodic or hard-wall boundaries
      *
      * Maps cartesian points to a grid of arbitrary resolution that
      * stores particle index.
      *
      * - cartesian space is assume to use all 8 octants (i.e. +/i round 0,0,0)
      * - grid space use only the first octant (all +)
-     * - resolution and size is set by `resize`
-     * - index of neighbors to a grid point
-     *   is obtained with `neighbors()`
-     * - index can be moved from one grid point to another with `move()`
-     * - the list of particle index in each grid point is stored in a
-     *   `std::set<int>` container.
-     *
-     * @todo
-     * - Update cell list based on Change object
-     * - Make a non-periodic version
-     * - std::set --> set::vector?
+     * - resolution and size is set by `resize`; the box is divided into
+     *   an integer number of cells, each at least `cutoff` wide so that
+     *   all points within `cutoff` are found in the 26+1 neighbor cells
+     * - each direction is either periodic (points are wrapped) or bounded
+     *   by hard walls (points are clamped to the outermost cells and the
+     *   stencil is truncated). Periodic directions need at least three cells.
+     * - index are stored contiguously, sorted by cell (counting sort), with
+     *   a small amount of free slots after each cell. Insertion, removal and
+     *   moving an index are therefore constant time operations; only if a
+     *   cell runs out of free slots is the layout rebuilt.
+     * - index of neighbors to a grid point is obtained with `neighbors()`
+     *   or, without copying, with `forEachNeighbor()`
+     * - all pairs in neighboring cells are visited exactly once with
+     *   `forEachPair()` using a half-shell stencil (own cell + 13 neighbors)
      *
      * @date Malmo, March 2018
      */
     template<typename CellPoint=Eigen::Vector3i>
         class CellList {
             typedef Eigen::Vector3d Point;
-            Point halfbox;
-            double cellsize=0; // cell side length (angstrom)
-            std::vector<std::vector<std::vector<std::set<int>>>> cells;
+            Point halfbox = {0,0,0};
+            Point cellsize = {0,0,0};        // cell side lengths (angstrom)
+            std::array<bool,3> pbc = {{true,true,true}}; // periodic directions
+            int ncells = 0;                  // total number of cells
+            std::vector<int> stencil;        // 27 neighbor cells for each cell (own, 13 forward, 13 backward); -1 if none
+            std::vector<int> offset;         // first slot of each cell in `members` (size ncells+1)
+            std::vector<int> count;          // number of index in each cell
+            std::vector<int> members;        // index sorted by cell
+            std::vector<int> cellOf;         // cell of each index (-1 if absent)
+            std::vector<int> slotOf;         // slot of each index in `members`
+
+            static int slack(int n) { return 2 + n/4; } //!< free slots reserved per cell
+
+            void layout() {
+                std::fill(count.begin(), count.end(), 0);
+                for (int c : cellOf)
+                    if (c>=0)
+                        count[c]++;
+                offset.resize(ncells+1);
+                offset[0] = 0;
+                for (int c=0; c<ncells; c++)
+                    offset[c+1] = offset[c] + count[c] + slack(count[c]);
+                members.assign(offset.back(), -1);
+                slotOf.assign(cellOf.size(), -1);
+                std::fill(count.begin(), count.end(), 0);
+                for (size_t i=0; i<cellOf.size(); i++) {
+                    int c = cellOf[i];
+                    if (c>=0) {
+                        int s = offset[c] + count[c]++;
+                        members[s] = i;
+                        slotOf[i] = s;
+                    }
+                }
+            } //!< (Re)build contiguous storage from `cellOf` (complexity: N + cells)
+
+            void makeStencils() {
+                std::vector<CellPoint> shell = {{0,0,0}}; // own cell, forward half, backward half
+                for (int dz=-1; dz<=1; dz++)
+                    for (int dy=-1; dy<=1; dy++)
+                        for (int dx=-1; dx<=1; dx++)
+                            if (dz>0 or (dz==0 and dy>0) or (dz==0 and dy==0 and dx>0))
+                                shell.push_back({dx,dy,dz});
+                for (size_t i=1; i<14; i++)
+                    shell.push_back(-shell[i]);
+                assert(shell.size()==27);
+                stencil.assign(27*ncells, -1);
+                for (int c=0; c<ncells; c++) {
+                    CellPoint a = index2cell(c);
+                    for (int i=0; i<27; i++) {
+                        CellPoint b = a + shell[i];
+                        bool inside = true;
+                        for (int d=0; d<3; d++) {
+                            if (pbc[d])
+                                b[d] = (b[d] + KLM[d] + 1) % (KLM[d] + 1);
+                            else if (b[d]<0 or b[d]>KLM[d])
+                                inside = false;
+                        }
+                        if (inside)
+                            stencil[27*c+i] = cell2index(b);
+                    }
+                }
+            } //!< Neighbor cells for each cell; non-periodic edges are truncated
+
+            template<class T>
+                void forEachIn(int c, T &f) const {
+                    for (int s=offset[c], end=offset[c]+count[c]; s<end; s++)
+                        f(members[s]);
+                }
 
             public:
 
             CellPoint KLM = {0,0,0}; // max cell index K,L,M
 
-            auto& operator[](const CellPoint &c) {
-                return cells[c[0]][c[1]][c[2]];
-            } //!< returns set with all index in given cell (complexity: constant)
-
             CellPoint p2c(const Point &p) const {
-                return ((p+halfbox)/cellsize).array().round().template cast<int>();
+                CellPoint c = (p+halfbox).cwiseQuotient(cellsize).array().floor().template cast<int>();
+                for (int d=0; d<3; d++) {
+                    if (pbc[d]) {
+                        c[d] %= KLM[d]+1;
+                        if (c[d]<0)
+                            c[d] += KLM[d]+1;
+                    } else
+                        c[d] = std::min(std::max(c[d], 0), int(KLM[d])); // hard wall
+                }
+                return c;
             } //!< cartesian point --> cell point
 
             Point c2p(const CellPoint &c) const {
-                return (c.template cast<double>()) * cellsize - halfbox;
-            } //!< cell point --> cartesian point
-
-            void move(int i, const CellPoint &src, const CellPoint &dst) {
-                assert( (*this)[src].count(i)==1 && "i not present in old cell");
-                assert( (*this)[dst].count(i)==0 && "i already in new cell");
-                (*this)[src].erase(i);
-                (*this)[dst].insert(i);
-            } //!< move particle index i from one cell to another (complexity: N log N)
-
-            void resize(const Point &box, double cutoff) {
-                clear();
+                return (c.template cast<double>()).cwiseProduct(cellsize) - halfbox;
+            } //!< cell point --> cartesian point (lower cell corner)
+
+            int cell2index(const CellPoint &c) const {
+                return c[0] + (KLM[0]+1) * (c[1] + (KLM[1]+1) * c[2]);
+            } //!< cell point --> linear cell index
+
+            CellPoint index2cell(int c) const {
+                int nx = KLM[0]+1, ny = KLM[1]+1;
+                return {c % nx, (c / nx) % ny, c / (nx*ny)};
+            } //!< linear cell index --> cell point
+
+            int cell(int i) const {
+                return (i < int(cellOf.size())) ? cellOf[i] : -1;
+            } //!< linear cell index of index `i`; -1 if not in list
+
+            bool contains(int i) const { return cell(i)>=0; }
+
+            size_t size(int c) const { return count[c]; } //!< number of index in cell `c`
+
+            void resize(const Point &box, double cutoff, const std::array<bool,3> &periodic={{true,true,true}}) {
+                CellPoint n = (box/cutoff).array().floor().template cast<int>();
+                for (int d=0; d<3; d++)
+                    if (periodic[d]) {
+                        if (n[d]<3)
+                            throw std::runtime_error("celllist error: too few grid point - cutoff or box too small");
+                    } else
+                        n[d] = std::max(n[d], 1);
+                pbc = periodic;
                 halfbox = 0.5*box;
-                cellsize = cutoff;
-                KLM = (box/cellsize).array().round().template cast<int>();
-                if (KLM.minCoeff()>=3) {
-                    cells.resize(KLM[0]+1);
-                    for (auto &k : cells) {
-                        k.resize(KLM[1]+1);
-                        for (auto &l : k)
-                            l.resize(KLM[2]+1);
-                    }
-                } else
-                    throw std::runtime_error("celllist error: too few grid point - cutoff or box too small");
-            }
+                cellsize = box.cwiseQuotient(n.template cast<double>());
+                KLM = n - CellPoint::Ones();
+                ncells = n.prod();
+                count.assign(ncells, 0);
+                cellOf.clear();
+                makeStencils();
+                layout();
+            } //!< Set grid dimensions; this clears all index
 
             void clear() {
-                for (auto &k : cells)
-                    for (auto &l : k)
-                        for (auto &m : l)
-                            m.clear();
+                std::fill(cellOf.begin(), cellOf.end(), -1);
+                layout();
             } //<! clear all index in cell list
 
+            void insert(int i, const Point &pos) {
+                assert(not contains(i) && "i already in list");
+                if (i >= int(cellOf.size())) {
+                    cellOf.resize(i+1, -1);
+                    slotOf.resize(i+1, -1);
+                }
+                int c = cell2index(p2c(pos));
+                cellOf[i] = c;
+                if (offset[c]+count[c] < offset[c+1]) {
+                    int s = offset[c] + count[c]++;
+                    members[s] = i;
+                    slotOf[i] = s;
+                } else
+                    layout(); // cell is full
+            } //!< Add index `i` at position `pos` (complexity: constant, amortized)
+
+            void erase(int i) {
+                int c = cell(i);
+                if (c>=0) {
+                    int s = slotOf[i], last = offset[c] + --count[c];
+                    members[s] = members[last]; // fill hole with last index in cell
+                    slotOf[members[s]] = s;
+                    members[last] = -1;
+                    cellOf[i] = slotOf[i] = -1;
+                }
+            } //!< Remove index `i`, if present (complexity: constant)
+
+            void update(int i, const Point &pos) {
+                int c = cell(i);
+                if (c<0)
+                    insert(i, pos);
+                else if (c != cell2index(p2c(pos))) {
+                    erase(i);
+                    insert(i, pos);
+                }
+            } //!< Move index `i` to new position `pos`, inserting if absent (complexity: constant)
+
             template<class Tpvec, class T=std::function<Point(const typename Tpvec::value_type&)>>
-                void update(const Tpvec &p, T getpos = [](auto &i){return i;} ) {
-                    clear();
+                void update(const Tpvec &p, T getpos = [](auto &i){return i;},
+                        std::function<bool(size_t)> include = [](size_t){return true;} ) {
+                    cellOf.assign(p.size(), -1);
                     for (size_t i=0; i<p.size(); i++)
-                        (*this)[ p2c( getpos(p[i]) ) ].insert(i);
-                }
+                        if (include(i))
+                            cellOf[i] = cell2index( p2c( getpos(p[i]) ) );
+                    layout();
+                } //!< Rebuild list with all (or the included) index in `p` (complexity: N)
+
+            template<class T>
+                void forEachNeighbor(int c, T f) const {
+                    for (int i=0; i<27; i++) {
+                        int n = stencil[27*c+i];
+                        if (n>=0)
+                            forEachIn(n, f);
+                    }
+                } //!< Call `f(j)` for all index in the 26+1 neighboring+own cells of linear cell `c`
+
+            template<class T>
+                void forEachPair(T f) const {
+                    for (int c=0; c<ncells; c++) {
+                        for (int s=offset[c], end=offset[c]+count[c]; s<end; s++) {
+                            int i = members[s];
+                            for (int t=s+1; t<end; t++) // pairs within own cell
+                                f(i, members[t]);
+                            for (int k=1; k<14; k++) { // forward half-shell
+                                int n = stencil[27*c+k];
+                                if (n>=0)
+                                    for (int t=offset[n], tend=offset[n]+count[n]; t<tend; t++)
+                                        f(i, members[t]);
+                            }
+                        }
+                    }
+                } //!< Call `f(i,j)` once for all pairs in neighboring cells (half-shell stencil)
+
+            template<class T>
+                void forEachInBox(const Point &lo, const Point &hi, T f) const {
+                    CellPoint a = (lo+halfbox).cwiseQuotient(cellsize).array().floor().template cast<int>();
+                    CellPoint b = (hi+halfbox).cwiseQuotient(cellsize).array().floor().template cast<int>();
+                    for (int d=0; d<3; d++) {
+                        if (pbc[d] and b[d]-a[d] < KLM[d])
+                            continue; // wrapped below
+                        a[d] = std::min(std::max(a[d], 0), int(KLM[d]));
+                        b[d] = std::min(std::max(b[d], 0), int(KLM[d]));
+                    }
+                    CellPoint c;
+                    for (int z=a[2]; z<=b[2]; z++)
+                        for (int y=a[1]; y<=b[1]; y++)
+                            for (int x=a[0]; x<=b[0]; x++) {
+                                c = {x,y,z};
+                                for (int d=0; d<3; d++)
+                                    if (pbc[d])
+                                        c[d] = (c[d] % (KLM[d]+1) + KLM[d]+1) % (KLM[d]+1);
+                                forEachIn(cell2index(c), f);
+                            }
+                } //!< Call `f(j)` for all index in cells overlapping the box [lo,hi]; each cell is visited once
 
-            void neighbors(const Eigen::Vector3i &c, std::vector<int> &index, bool clear=true) const {
+            void neighbors(const CellPoint &c, std::vector<int> &index, bool clear=true) const {
                 if (clear)
                     index.clear();
-                int cnt=0;
-                std::array<int,3>
-                    k = {{ c[0]-1, c[0], c[0]+1 }},
-                    l = {{ c[1]-1, c[1], c[1]+1 }},
-                    m = {{ c[2]-1, c[2], c[2]+1 }};
-                if (k[0]<0) k[0]=KLM[0]; else if (k[2]>KLM[0]) k[2]=0;
-                if (l[0]<0) l[0]=KLM[1]; else if (l[2]>KLM[1]) l[2]=0;
-                if (m[0]<0) m[0]=KLM[2]; else if (m[2]>KLM[2]) m[2]=0;
-                for (int _k : k)
-                    for (int _l : l)
-                        for (int _m : m) {
-                            cnt++;
-                            auto& s = cells[_k][_l][_m];
-                            std::copy(s.begin(), s.end(), std::back_inserter(index));
-                        }
-                assert(cnt==27);
+                forEachNeighbor(cell2index(c), [&index](int j){ index.push_back(j); });
             } //!< Index from all 26+1 neighboring+own cells (complexity: N neighbors)
         };
 
@@ -121,26 +280,112 @@ namespace Faunus {
         Point box = {10,20,6};
         CellList<Eigen::Vector3i> l;
         l.resize(box, 2);
-        CHECK( l.KLM==Eigen::Vector3i(5,10,3) );
-        CHECK( l.p2c( {5,10,3} ) == l.KLM );
+        CHECK( l.KLM==Eigen::Vector3i(4,9,2) );
+        CHECK( l.p2c( {4.9,9.9,2.9} ) == l.KLM );
+        CHECK( l.p2c( {5,10,3} ) == Eigen::Vector3i(0,0,0) ); // periodic wrap
         CHECK( l.p2c( {-5,-10,-3} ) == Eigen::Vector3i(0,0,0) );
-        CHECK( l.p2c( {0,0,0} ) == Eigen::Vector3i(3,5,2) );
+        CHECK( l.p2c( {0,0,0} ) == Eigen::Vector3i(2,5,1) );
+        CHECK( l.index2cell( l.cell2index( {3,7,1} ) ) == Eigen::Vector3i(3,7,1) );
+        CHECK_THROWS( l.resize(box, 2.1) ); // only two cells in z
 
         std::vector<int> index; // index of neighbors (and self) in...
         std::vector<Point> vec; // ...array of points
 
-        vec = {{0,0,0}, {0,3,0}};
+        vec = {{0,0,0}, {0,4,0}};
         l.update(vec);
         l.neighbors( l.p2c( vec[0] ), index);
         CHECK( index.size()==1 );  // alone by myself...
         CHECK( index.front()==0 ); // ...am I really me?
 
-        vec = {{0,0,0}, {0,-3,0}};
+        vec = {{0,0,0}, {0,-2,0}};
         l.update(vec);
         l.neighbors( l.p2c( vec[0] ), index);
         CHECK( index.size()==2 );  // now we're two
         l.neighbors( l.p2c( vec[1] ), index);
         CHECK( index.size()==2 );  // now we're two
+
+        vec = {{-4.9,0,0}, {4.9,0,0}}; // neighbors across the periodic boundary
+        l.update(vec);
+        l.neighbors( l.p2c( vec[0] ), index);
+        CHECK( index.size()==2 );
+
+        SUBCASE("hard walls") {
+            CellList<Eigen::Vector3i> w;
+            w.resize(box, 2, {{false,true,true}}); // walls in x
+            w.update(vec);
+            w.neighbors( w.p2c( vec[0] ), index);
+            CHECK( index.size()==1 );
+            CHECK( w.p2c( {5.1,0,0} ).x() == w.KLM.x() ); // outside points are clamped
+            CHECK( w.p2c( {-5.1,0,0} ).x() == 0 );
+            w.resize({10,20,1}, 2, {{true,true,false}}); // thin slab
+            CHECK( w.KLM.z() == 0 );
+        }
+
+        SUBCASE("insert, erase and move") {
+            l.update(vec);
+            l.insert(5, {0,0,0});
+            CHECK( l.contains(5) );
+            CHECK( not l.contains(3) );
+            for (int i=0; i<20; i++) // overflow free slots in cell
+                l.insert(10+i, {0.1,0.1,0.1});
+            CHECK( l.size( l.cell(5) ) == 21 );
+            l.erase(5);
+            CHECK( l.size( l.cell(10) ) == 20 );
+            l.update(10, {-4.9,0,0}); // move to other cell
+            CHECK( l.cell(10) == l.cell(0) );
+            CHECK( l.size( l.cell(0) ) == 2 );
+            l.neighbors( l.p2c( vec[1] ), index);
+            CHECK( index.size()==3 );
+            l.erase(10);
+            l.erase(10); // already gone
+            l.neighbors( l.p2c( vec[1] ), index);
+            CHECK( index.size()==2 );
+        }
+
+        SUBCASE("box query") {
+            std::vector<Point> p(300);
+            for (size_t i=0; i<p.size(); i++)
+                p[i] = Point(std::fmod(i*1.618, 10.0), std::fmod(i*3.141, 20.0), std::fmod(i*2.718, 6.0)) - 0.5*box;
+            l.update(p);
+            for (Point c : {Point(0,0,0), Point(4.5,-9.5,2.5), Point(-4,3,0)}) {
+                Point lo = c - Point(2.5,3,1), hi = c + Point(2.5,3,1);
+                std::vector<int> hits(p.size(), 0);
+                l.forEachInBox(lo, hi, [&](int j){ hits[j]++; });
+                bool ok = true;
+                for (size_t i=0; i<p.size(); i++) {
+                    Point d = p[i] - c;
+                    for (int k=0; k<3; k++)
+                        d[k] -= box[k] * std::round(d[k]/box[k]);
+                    bool inside = std::fabs(d.x())<=2.5 and std::fabs(d.y())<=3 and std::fabs(d.z())<=1;
+                    if (hits[i]>1 or (inside and hits[i]==0))
+                        ok = false;
+                }
+                CHECK(ok); // all points in the box are found, none twice
+            }
+            int n = 0;
+            l.forEachInBox(Point(-20,-20,-20), Point(20,20,20), [&](int){ n++; });
+            CHECK(n == int(p.size()));
+        }
+
+        SUBCASE("half-shell pairs") {
+            std::vector<Point> p(300);
+            for (size_t i=0; i<p.size(); i++)
+                p[i] = Point(std::fmod(i*1.618, 10.0), std::fmod(i*3.141, 20.0), std::fmod(i*2.718, 6.0)) - 0.5*box;
+            l.update(p);
+            std::vector<int> hits(p.size()*p.size(), 0);
+            l.forEachPair([&](int i, int j){ hits[i*p.size()+j]++; hits[j*p.size()+i]++; });
+            bool ok = true;
+            for (size_t i=0; i<p.size(); i++)
+                for (size_t j=0; j<p.size(); j++)
+                    if (i!=j) {
+                        Point r = p[i]-p[j];
+                        for (int d=0; d<3; d++) // minimum image
+                            r[d] -= box[d]*std::round(r[d]/box[d]);
+                        if (hits[i*p.size()+j] > 1 or (r.norm() < 2 and hits[i*p.size()+j] != 1))
+                            ok = false;
+                    }
+            CHECK( ok );
+        }
     }
 #endif
 } // namespace
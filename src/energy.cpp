@@ -13,6 +13,12 @@ void Energybase::sync(Energybase *, Change &) {}
 
 void Energybase::init() {}
 
+bool Energybase::hasDelta(const Change &) const { return false; }
+
+double Energybase::delta(Change &, const Tspace &, const Tspace &) {
+    throw std::runtime_error(name + ": single pass energy change not implemented");
+}
+
 void to_json(json &j, const Energybase &base) {
     assert(not base.name.empty());
     if (base.timer)
@@ -27,8 +33,10 @@ void EwaldData::update(const Point &box) {
     int kcc = std::ceil(kc);
     check_k2_zero = 0.1 * std::pow(2 * pc::pi / L.maxCoeff(), 2);
     int kVectorsLength = (2 * kcc + 1) * (2 * kcc + 1) * (2 * kcc + 1) - 1;
+    nmax = kcc;
     if (kVectorsLength == 0) {
         kVectors.resize(3, 1);
+        kIndices.setZero(3, 1);
         Aks.resize(1);
         kVectors.col(0) = Point(1, 0, 0); // Just so it is not the zero-vector
         Aks[0] = 0;
@@ -38,6 +46,7 @@ void EwaldData::update(const Point &box) {
     } else {
         double kc2 = kc * kc;
         kVectors.resize(3, kVectorsLength);
+        kIndices.resize(3, kVectorsLength);
         Aks.resize(kVectorsLength);
         kVectorsInUse = 0;
         kVectors.setZero();
@@ -64,6 +73,7 @@ void EwaldData::update(const Point &box) {
                         if ((dkx2 / kc2) + (dky2 / kc2) + (dkz2 / kc2) > 1)
                             continue;
                     kVectors.col(kVectorsInUse) = kv;
+                    kIndices.col(kVectorsInUse) << kx, ky, kz;
                     Aks[kVectorsInUse] = factor * std::exp(-k2 / (4 * alpha * alpha)) / k2;
                     kVectorsInUse++;
                 }
@@ -73,6 +83,7 @@ void EwaldData::update(const Point &box) {
         Qdip.resize(kVectorsInUse);
         Aks.conservativeResize(kVectorsInUse);
         kVectors.conservativeResize(3, kVectorsInUse);
+        kIndices.conservativeResize(3, kVectorsInUse);
     }
 }
 
@@ -82,6 +93,11 @@ void from_json(const json &j, EwaldData &d) {
     d.kc = j.at("kcutoff");
     d.ipbc = j.value("ipbc", false);
     d.spherical_sum = j.value("spherical_sum", true);
+    d.cache = j.value("cache", false);
+    d.omp_enable = j.value("openmp", false);
+    d.mesh = j.value("mesh", 0);
+    d.order = j.value("order", 4);
+    d.tuning = j.value("auto", json());
     d.lB = pc::lB(j.at("epsr"));
     d.eps_surf = j.value("epss", 0.0);
     d.const_inf = (d.eps_surf < 1) ? 0 : 1; // if unphysical (<1) use epsr infinity for surrounding medium
@@ -95,7 +111,100 @@ void to_json(json &j, const EwaldData &d) {
          {"cutoff", d.rc},
          {"kcutoff", d.kc},
          {"wavefunctions", d.kVectors.cols()},
+         {"cache", d.cache},
+         {"openmp", d.omp_enable},
          {"spherical_sum", d.spherical_sum}};
+    if (d.mesh > 0) { // particle-mesh Ewald
+        j["mesh"] = d.mesh;
+        j["order"] = d.order;
+    }
+    if (not d.tuning.is_null())
+        j["auto"] = d.tuning;
+}
+
+double ewaldRealError(double Q2, double alpha, double rc, double V) {
+    double x2 = alpha * alpha * rc * rc;
+    return Q2 * std::sqrt(rc / (2 * V)) * std::exp(-x2) / x2;
+}
+
+double ewaldReciprocalError(double Q2, double alpha, double kc, double L) {
+    return Q2 * alpha / (pc::pi * pc::pi) * std::pow(kc, -1.5) * std::exp(-std::pow(pc::pi * kc / (alpha * L), 2));
+}
+
+/*
+ * Time of a real space pair, erfc(alpha*r)/r, relative to a k-vector update, exp(ik.r),
+ * for a single particle
+ */
+static double ewaldPairCost() {
+    using clock = std::chrono::steady_clock;
+    const int n = 1000000;
+    volatile double sink = 0;
+    double sum = 0;
+    auto t0 = clock::now();
+    for (int i = 0; i < n; i++) {
+        double r = 1 + (i % 1000) * 0.01;
+        sum += std::erfc(0.3 * r) / r;
+    }
+    auto t1 = clock::now();
+    for (int i = 0; i < n; i++) {
+        double kr = (i % 1000) * 0.01;
+        sum += std::cos(kr) + std::sin(kr);
+    }
+    auto t2 = clock::now();
+    sink = sum;
+    (void)sink;
+    return std::chrono::duration<double>(t1 - t0).count() / std::chrono::duration<double>(t2 - t1).count();
+}
+
+void tuneEwald(json &j, const Point &box, int N, double Q2) {
+    auto &tuning = j.at("auto");
+    double accuracy = tuning.at("accuracy").get<double>() / std::sqrt(2.0); // for each of real and reciprocal
+    if (accuracy <= 0)
+        throw std::runtime_error("ewald: accuracy must be positive");
+    double paircost = tuning.value("paircost", 1.0);
+    if (tuning.value("benchmark", false))
+        paircost = ewaldPairCost();
+    bool spherical = j.value("spherical_sum", true);
+    double lB = pc::lB(j.at("epsr")), V = box.prod(), L = box.maxCoeff(), rho = N / V;
+    Q2 *= lB; // errors in kT
+
+    double best = pc::infty, alpha_best = 0, rc_best = 0, kc_best = 0;
+    const int steps = 100;
+    for (int i = 1; i <= steps; i++) {
+        double rc = 0.5 * box.minCoeff() * i / steps;
+        double lo = 1e-3 / rc, hi = 10 / rc; // smallest alpha meeting the real space accuracy
+        if (ewaldRealError(Q2, hi, rc, V) > accuracy)
+            continue;
+        for (int n = 0; n < 60; n++) { // bisection
+            double mid = 0.5 * (lo + hi);
+            if (ewaldRealError(Q2, mid, rc, V) > accuracy)
+                lo = mid;
+            else
+                hi = mid;
+        }
+        double alpha = hi;
+        int kc = 1; // smallest k-vector index meeting the reciprocal accuracy
+        while (kc < 100 and ewaldReciprocalError(Q2, alpha, kc, L) > accuracy)
+            kc++;
+        if (ewaldReciprocalError(Q2, alpha, kc, L) > accuracy)
+            continue;
+        double kvectors = spherical ? 2 * pc::pi / 3 * std::pow(kc, 3) : 0.5 * (std::pow(2 * kc + 1, 3) - 1);
+        double cost = paircost * rho * 4 * pc::pi / 3 * std::pow(rc, 3) + kvectors;
+        if (cost < best) {
+            best = cost;
+            alpha_best = alpha;
+            rc_best = rc;
+            kc_best = kc;
+        }
+    }
+    if (best == pc::infty)
+        throw std::runtime_error("ewald: accuracy cannot be reached");
+    j["alpha"] = alpha_best;
+    j["cutoff"] = rc_best;
+    j["kcutoff"] = kc_best;
+    tuning["paircost"] = paircost;
+    tuning["real error"] = ewaldRealError(Q2, alpha_best, rc_best, V);
+    tuning["reciprocal error"] = ewaldReciprocalError(Q2, alpha_best, kc_best, L);
 }
 
 double Example2D::energy(Change &) {
@@ -204,6 +313,7 @@ void Isobaric::to_json(json &j) const {
 Constrain::Constrain(const json &j, Tspace &spc) {
     using namespace Faunus::ReactionCoordinate;
     name = "constrain";
+    umin = 0; // zero or infinity
     type = j.at("type").get<std::string>();
     try {
         if (type == "atom")
@@ -235,102 +345,157 @@ void Constrain::to_json(json &j) const {
     j["type"] = type;
     j.erase("resolution");
 }
-void Bonded::update_intra() {
-    using namespace Potential;
-    intra.clear();
+void Bonded::build_index(const BondVector &inter) {
+    bonds.clear();
+    bond_group.clear();
+    group_of.assign(spc.p.size(), -1);
     for (size_t i = 0; i < spc.groups.size(); i++) {
         auto &group = spc.groups.at(i);
+        int offset = std::distance(spc.p.begin(), group.begin());
+        std::fill(group_of.begin() + offset, group_of.begin() + offset + group.capacity(), i);
         for (auto &bond : molecules.at(group.id).bonds) {
-            intra[i].push_back(bond->clone()); // deep copy BondData from MoleculeData
-            intra[i].back()->shift(std::distance(spc.p.begin(), group.begin()));
-            Potential::setBondEnergyFunction(intra[i].back(), spc.p);
+            bonds.push_back(bond->clone()); // deep copy BondData from MoleculeData
+            bonds.back()->shift(offset);
+            bond_group.push_back(i);
         }
     }
-}
-double Bonded::sum_energy(const Bonded::BondVector &bonds) const {
-    double energy = 0;
+    for (auto &bond : inter) {
+        bonds.push_back(bond);
+        bond_group.push_back(-1);
+    }
+    csr_offset.assign(spc.p.size() + 1, 0);
     for (auto &bond : bonds) {
-        assert(bond->hasEnergyFunction());
-        energy += bond->energy(spc.geo.getDistanceFunc());
+        for (int i : bond->index)
+            if (i < 0 or i >= int(spc.p.size()))
+                throw std::runtime_error("bond index out of range");
+        Potential::setBondEnergyFunction(bond, spc.p);
+        for (int i : bond->index)
+            csr_offset[i + 1]++;
     }
-    return energy;
+    std::partial_sum(csr_offset.begin(), csr_offset.end(), csr_offset.begin());
+    csr_bonds.resize(csr_offset.back());
+    std::vector<int> fill(csr_offset.begin(), csr_offset.end() - 1);
+    for (size_t k = 0; k < bonds.size(); k++)
+        for (int i : bonds[k]->index)
+            csr_bonds[fill[i]++] = k;
+    visited.assign(bonds.size(), 0);
+    stamp = 0;
+}
+bool Bonded::is_active(int k) const {
+    for (int i : bonds[k]->index) {
+        int g = group_of[i];
+        if (g >= 0 and i >= std::distance(spc.p.begin(), spc.groups[g].end()))
+            return false;
+    }
+    return true;
 }
-double Bonded::sum_energy(const Bonded::BondVector &bonds, const std::vector<int> &particles_ndx) const {
-    double energy = 0;
-    // outer loop over bonds to ensure that each bond is counted at most once
-    for (auto &bond : bonds) {
-        for (auto particle_ndx : particles_ndx) {
-            if (std::find(bond->index.begin(), bond->index.end(), particle_ndx) != bond->index.end()) {
-                assert(bond->hasEnergyFunction());
-                energy += bond->energy(spc.geo.getDistanceFunc());
-                break; // count each interaction at most once
+const std::vector<int> &Bonded::touched_bonds(const Change &change) {
+    touched.clear();
+    if (++stamp == 0) { // counter wrapped around
+        std::fill(visited.begin(), visited.end(), 0);
+        stamp = 1;
+    }
+    for (auto &d : change.groups) {
+        auto add = [&](int i) { // intra-molecular bonds count only if the internal structure changed
+            for (int n = csr_offset[i]; n < csr_offset[i + 1]; n++) {
+                int k = csr_bonds[n];
+                if (visited[k] != stamp and (d.internal or bond_group[k] < 0)) {
+                    visited[k] = stamp;
+                    touched.push_back(k);
+                }
             }
-        }
+        };
+        auto &group = spc.groups.at(d.index);
+        int offset = std::distance(spc.p.begin(), group.begin());
+        if (d.all)
+            for (size_t i = 0; i < group.capacity(); i++)
+                add(offset + i);
+        else
+            for (int i : d.atoms)
+                add(offset + i);
+    }
+    return touched;
+}
+void Bonded::bind_old(const Tspace &old) {
+    old_spc = &old;
+    bonds_old.clear();
+    for (auto &bond : bonds) {
+        bonds_old.push_back(bond->clone());
+        Potential::setBondEnergyFunction(bonds_old.back(), old.p);
     }
-    return energy;
 }
 Bonded::Bonded(const json &j, Tspace &spc) : spc(spc) {
     name = "bonded";
-    update_intra();
+    BondVector inter;
     if (j.is_object())
         if (j.count("bondlist") == 1)
             inter = j["bondlist"].get<BondVector>();
-    for (auto &i : inter) // set all energy functions
-        Potential::setBondEnergyFunction(i, spc.p);
+    build_index(inter);
 }
 void Bonded::to_json(json &j) const {
+    json inter = json::array(), intra = json::array();
+    for (size_t k = 0; k < bonds.size(); k++)
+        (bond_group[k] < 0 ? inter : intra).push_back(bonds[k]);
     if (!inter.empty())
         j["bondlist"] = inter;
-    if (!intra.empty()) {
-        json &_j = j["bondlist-intramolecular"];
-        _j = json::array();
-        for (auto &i : intra)
-            for (auto &b : i.second)
-                _j.push_back(b);
-    }
+    if (!intra.empty())
+        j["bondlist-intramolecular"] = intra;
 }
 double Bonded::energy(Change &change) {
     double energy = 0;
     if (change) {
-        energy += sum_energy(inter); // energy of inter-molecular bonds
-
-        if (change.all || change.dV) {              // compute all active groups
-            for (auto &i : intra) {                 // energies of intra-molecular bonds
-                if (!spc.groups[i.first].empty()) { // add only if group is active
-                    energy += sum_energy(i.second);
-                }
-            }
-        } else { // compute only the affected groups
-            for (auto &group : change.groups) {
-                auto &intra_group = intra[group.index];
-                if (group.internal) {
-                    if (group.all) { // all internal positions updated
-                        if (not spc.groups[group.index].empty())
-                            energy += sum_energy(intra_group);
-                    } else { // only partial update of affected atoms
-                        std::vector<int> atoms_ndx;
-                        // an offset is the index of the first particle in the group
-                        int offset = std::distance(spc.p.begin(), spc.groups[group.index].begin());
-                        // add an offset to the group atom indices to get the absolute indices
-                        std::transform(group.atoms.begin(), group.atoms.end(), std::back_inserter(atoms_ndx),
-                                       [offset](int i) { return i + offset; });
-                        energy += sum_energy(intra_group, atoms_ndx);
-                    }
-                }
-            }
-        } // for-loop over groups
+        auto dist = spc.geo.getDistanceFunc();
+        if (change.all || change.dV) { // all active bonds
+            for (size_t k = 0; k < bonds.size(); k++)
+                if (is_active(k))
+                    energy += bonds[k]->energy(dist);
+        } else // only bonds touching moved particles
+            for (int k : touched_bonds(change))
+                if (is_active(k))
+                    energy += bonds[k]->energy(dist);
     }
     return energy;
 }
+bool Bonded::hasDelta(const Change &change) const { return not(change.all or change.dV or change.dN); }
+
+double Bonded::delta(Change &change, const Tspace &old, const Tspace &) {
+    if (old_spc != &old)
+        bind_old(old);
+    auto dist = spc.geo.getDistanceFunc();
+    double du = 0;
+    for (int k : touched_bonds(change))
+        if (is_active(k))
+            du += bonds[k]->energy(dist) - bonds_old[k]->energy(dist);
+    return du;
+}
 void Hamiltonian::to_json(json &j) const {
     for (auto i : this->vec)
         j.push_back(*i);
 }
 void Hamiltonian::addEwald(const json &j, Tspace &spc) {
     if (j.count("coulomb") == 1)
-        if (j["coulomb"].count("type") == 1)
+        if (j["coulomb"].count("type") == 1) {
             if (j["coulomb"].at("type") == "ewald")
                 push_back<Energy::Ewald<>>(j["coulomb"], spc);
+            else if (j["coulomb"].at("type") == "pme")
+                push_back<Energy::Ewald<PolicyPME>>(j["coulomb"], spc);
+        }
+}
+void Hamiltonian::tuneEwald(json &j, Tspace &spc) {
+    if (j.count("coulomb") == 1)
+        if (j["coulomb"].count("auto") == 1) {
+            std::string type = j["coulomb"].value("type", "");
+            if (type != "ewald" and type != "pme")
+                throw std::runtime_error("automatic parameters require Ewald summation");
+            int N = 0;
+            double Q2 = 0;
+            for (auto &p : spc.activeParticles())
+                if (p.charge != 0) {
+                    N++;
+                    Q2 += p.charge * p.charge;
+                }
+            Energy::tuneEwald(j["coulomb"], spc.geo.getLength(), N, Q2);
+        }
 }
 void Hamiltonian::addSelfEnergy(const json &j, Tspace &spc) {
     std::vector<std::string> methods = {"qpotential", "fanourgakis"};
@@ -358,69 +523,101 @@ Hamiltonian::Hamiltonian(Tspace &spc, const json &j) {
         size_t oldsize = vec.size();
         for (auto it = m.begin(); it != m.end(); ++it) {
             try {
+                json value = it.value(); // copy, possibly with tuned Ewald parameters
+                tuneEwald(value, spc);
+
                 if (it.key() == "nonbonded_coulomblj")
-                    push_back<Energy::Nonbonded<CoulombLJ>>(it.value(), spc);
+                    push_back<Energy::Nonbonded<CoulombLJ>>(value, spc);
 
                 if (it.key() == "nonbonded_coulomblj_EM")
-                    push_back<Energy::NonbondedCached<CoulombLJ>>(it.value(), spc);
+                    push_back<Energy::NonbondedCached<CoulombLJ>>(value, spc);
 
                 if (it.key() == "nonbonded")
-                    push_back<Energy::Nonbonded<TabulatedPotential<typename Tspace::Tparticle>>>(it.value(), spc);
+                    push_back<Energy::Nonbonded<TabulatedPotential<typename Tspace::Tparticle>>>(value, spc);
 
                 if (it.key() == "nonbonded_exact")
-                    push_back<Energy::Nonbonded<FunctorPotential<typename Tspace::Tparticle>>>(it.value(), spc);
+                    push_back<Energy::Nonbonded<FunctorPotential<typename Tspace::Tparticle>>>(value, spc);
 
                 if (it.key() == "nonbonded_cached")
-                    push_back<Energy::NonbondedCached<TabulatedPotential<typename Tspace::Tparticle>>>(it.value(), spc);
+                    push_back<Energy::NonbondedCached<TabulatedPotential<typename Tspace::Tparticle>>>(value, spc);
 
                 if (it.key() == "nonbonded_coulombwca")
-                    push_back<Energy::Nonbonded<CoulombWCA>>(it.value(), spc);
+                    push_back<Energy::Nonbonded<CoulombWCA>>(value, spc);
 
                 if (it.key() == "nonbonded_pm" or it.key() == "nonbonded_coulombhs")
-                    push_back<Energy::Nonbonded<PrimitiveModel>>(it.value(), spc);
+                    push_back<Energy::Nonbonded<PrimitiveModel>>(value, spc);
 
                 if (it.key() == "nonbonded_pmwca")
-                    push_back<Energy::Nonbonded<PrimitiveModelWCA>>(it.value(), spc);
+                    push_back<Energy::Nonbonded<PrimitiveModelWCA>>(value, spc);
 
                 if (it.key() == "bonded")
-                    push_back<Energy::Bonded>(it.value(), spc);
+                    push_back<Energy::Bonded>(value, spc);
 
                 if (it.key() == "customexternal")
-                    push_back<Energy::CustomExternal>(it.value(), spc);
+                    push_back<Energy::CustomExternal>(value, spc);
 
                 if (it.key() == "akesson")
-                    push_back<Energy::ExternalAkesson>(it.value(), spc);
+                    push_back<Energy::ExternalAkesson>(value, spc);
 
                 if (it.key() == "confine")
-                    push_back<Energy::Confine>(it.value(), spc);
+                    push_back<Energy::Confine>(value, spc);
 
                 if (it.key() == "constrain")
-                    push_back<Energy::Constrain>(it.value(), spc);
+                    push_back<Energy::Constrain>(value, spc);
 
                 if (it.key() == "example2d")
-                    push_back<Energy::Example2D>(it.value(), spc);
+                    push_back<Energy::Example2D>(value, spc);
 
                 if (it.key() == "isobaric")
-                    push_back<Energy::Isobaric>(it.value(), spc);
+                    push_back<Energy::Isobaric>(value, spc);
 
                 if (it.key() == "penalty")
 #ifdef ENABLE_MPI
-                    push_back<Energy::PenaltyMPI>(it.value(), spc);
+                    push_back<Energy::PenaltyMPI>(value, spc);
 #else
-                    push_back<Energy::Penalty>(it.value(), spc);
+                    push_back<Energy::Penalty>(value, spc);
 #endif
 #ifdef ENABLE_POWERSASA
                 if (it.key() == "sasa")
-                    push_back<Energy::SASAEnergy>(it.value(), spc);
+                    push_back<Energy::SASAEnergy>(value, spc);
 #endif
                 // additional energies go here...
 
-                addEwald(it.value(), spc); // add reciprocal Ewald terms if appropriate
+                addEwald(value, spc); // add reciprocal Ewald terms if appropriate
 
-                addSelfEnergy(it.value(), spc); // add self-term of electrostatic potential if appropriate
+                addSelfEnergy(value, spc); // add self-term of electrostatic potential if appropriate
 
                 if (it.key() == "maxenergy") {
-                    maxenergy = it.value().get<double>();
+                    maxenergy = value.get<double>();
+                    continue;
+                }
+
+                if (it.key() == "delta") {
+                    delta_enable = value.get<bool>();
+                    continue;
+                }
+
+                if (it.key() == "ledger") {
+                    ledger_enable = value.get<bool>();
+                    continue;
+                }
+
+                if (it.key() == "adaptiveorder") {
+                    adaptive_enable = value.get<bool>();
+                    continue;
+                }
+
+                if (it.key() == "earlyreject") {
+                    earlyreject_enable = value.get<bool>();
+                    continue;
+                }
+
+                if (it.key() == "concurrent") {
+                    concurrent_enable = value.get<bool>();
+#ifndef _OPENMP
+                    if (concurrent_enable)
+                        std::cerr << "warning: concurrent energy evaluation requests unavailable OpenMP." << endl;
+#endif
                     continue;
                 }
 
@@ -432,14 +629,147 @@ Hamiltonian::Hamiltonian(Tspace &spc, const json &j) {
             }
         }
     }
+    resizeLedger();
+}
+void Hamiltonian::resizeLedger() {
+    last.resize(size(), 0);
+    last_valid.assign(size(), false);
+    ledger_system.resize(size(), 0);
+    ledger_system_valid.resize(size(), false);
+    ledger_group.resize(size());
 }
 double Hamiltonian::energy(Change &change) {
     double du = 0;
-    for (auto i : this->vec) {
-        i->key = key;
-        i->timer.start();
-        du += i->energy(change);
-        i->timer.stop();
+    std::fill(last_valid.begin(), last_valid.end(), false); // terms may be skipped below
+    /*
+     * With a limit, `Change::umax`, each term is given the limit minus the energy summed so
+     * far and minus the lower bounds of the remaining terms. Summing stops once the limit is
+     * provably reached, which always holds for positive infinity.
+     */
+    double umax = change.umax, rest = 0; // rest = lower bound of terms not yet evaluated
+    if (umax < pc::infty)
+        for (auto term : this->vec)
+            rest += term->umin;
+    bool adapt = adaptive_enable and key == NEW and ordering != nullptr and ordering->order.size() == size();
+    for (size_t n = 0; n < size(); n++) {
+        size_t i = adapt ? ordering->order[n] : n;
+        auto &term = this->vec[i];
+        term->key = key;
+        if (umax < pc::infty) {
+            rest -= term->umin;
+            double limit = umax - du - rest;
+            change.umax = (limit < pc::infty) ? limit : std::numeric_limits<double>::max(); // NaN or inf
+        }
+        term->timer.start();
+        last[i] = term->energy(change);
+        double time = term->timer.stop();
+        if (adapt) {
+            ordering->stat[i].time += time;
+            if (last[i] >= pc::infty)
+                ordering->stat[i].infcnt++;
+        }
+        last_valid[i] = true;
+        du += last[i];
+        if (du >= maxenergy)
+            break; // stop summing energies
+        if (umax < pc::infty and (du + rest >= umax or du >= pc::infty))
+            break; // move will be rejected
+    }
+    if (umax < pc::infty)
+        change.umax = umax; // restore only if modified, as `change` may be read concurrently
+    if (adapt and ++ordering->cnt % adaptive_interval == 0)
+        reorder(*ordering);
+    return du;
+}
+void Hamiltonian::reorder(Ordering &o) {
+    std::vector<double> cost(size()); // expected time spent per rejection
+    for (size_t i = 0; i < size(); i++)
+        cost[i] = (o.stat[i].infcnt > 0) ? o.stat[i].time / o.stat[i].infcnt : pc::infty;
+    std::iota(o.order.begin(), o.order.end(), 0); // ties, including never rejecting terms, keep input order
+    std::stable_sort(o.order.begin(), o.order.end(), [&](size_t a, size_t b) { return cost[a] < cost[b]; });
+}
+void Hamiltonian::select(const std::string &move) {
+    if (adaptive_enable) {
+        ordering = &orderings[move];
+        if (ordering->order.size() != size()) {
+            ordering->order.resize(size());
+            std::iota(ordering->order.begin(), ordering->order.end(), 0);
+            ordering->stat.assign(size(), TermStatistics());
+        }
+    }
+}
+std::map<std::string, std::vector<std::string>> Hamiltonian::termOrder() const {
+    std::map<std::string, std::vector<std::string>> m;
+    for (auto &o : orderings)
+        for (size_t i : o.second.order)
+            m[o.first].push_back(this->vec.at(i)->name);
+    return m;
+}
+double Hamiltonian::ledgerTerm(size_t i, Change &change) {
+    auto &term = this->vec[i];
+    if (ledger_enable and not(change.all or change.dV)) {
+        if (term->ledger == SYSTEM and ledger_system_valid[i])
+            return ledger_system[i];
+        if (term->ledger == GROUP and not change.dN and not change.groups.empty()) {
+            double u = 0;
+            auto &groups = ledger_group[i];
+            auto d = change.groups.begin();
+            for (; d != change.groups.end(); ++d) {
+                auto it = groups.find(d->index);
+                if (not d->all or it == groups.end())
+                    break;
+                u += it->second;
+            }
+            if (d == change.groups.end()) // all groups found in ledger
+                return u;
+        }
+    }
+    term->key = key;
+    term->timer.start();
+    double u = term->energy(change);
+    term->timer.stop();
+    if (ledger_enable and change)
+        record(i, change, u);
+    return u;
+}
+void Hamiltonian::record(size_t i, Change &change, double u) {
+    auto &term = this->vec[i];
+    if (term->ledger == SYSTEM) {
+        ledger_system[i] = u;
+        ledger_system_valid[i] = true;
+    } else if (term->ledger == GROUP) {
+        bool single = change.groups.size() == 1 and change.groups[0].all;
+        if (single and not(change.all or change.dV or change.dN))
+            ledger_group[i][change.groups[0].index] = u;
+    }
+}
+double Hamiltonian::ledgerEnergy(Change &change) {
+    double u = 0;
+    for (size_t i = 0; i < size(); i++) {
+        u += ledgerTerm(i, change);
+        if (u >= maxenergy)
+            break; // stop summing energies
+    }
+    return u;
+}
+double Hamiltonian::delta(Change &change, Hamiltonian &old, const Tspace &oldspc, const Tspace &trialspc) {
+    assert(old.size() == size());
+    double du = 0;
+    std::fill(last_valid.begin(), last_valid.end(), false); // terms may be skipped below
+    for (size_t i = 0; i < size(); i++) {
+        auto &trial_term = this->vec[i];
+        auto &old_term = old.vec[i];
+        trial_term->key = NEW;
+        old_term->key = OLD;
+        trial_term->timer.start();
+        if (delta_enable and trial_term->hasDelta(change))
+            du += trial_term->delta(change, oldspc, trialspc);
+        else { // two passes for terms without single pass support
+            last[i] = trial_term->energy(change);
+            last_valid[i] = true;
+            du += last[i] - old.ledgerTerm(i, change);
+        }
+        trial_term->timer.stop();
         if (du >= maxenergy)
             break; // stop summing energies
     }
@@ -448,6 +778,10 @@ double Hamiltonian::energy(Change &change) {
 void Hamiltonian::init() {
     for (auto i : this->vec)
         i->init();
+    resizeLedger();
+    std::fill(ledger_system_valid.begin(), ledger_system_valid.end(), false);
+    for (auto &groups : ledger_group)
+        groups.clear();
 }
 void Hamiltonian::sync(Energybase *basePtr, Change &change) {
     auto other = dynamic_cast<decltype(this)>(basePtr);
@@ -455,25 +789,147 @@ void Hamiltonian::sync(Energybase *basePtr, Change &change) {
         if (other->size() == size()) {
             for (size_t i = 0; i < size(); i++)
                 this->vec[i]->sync(other->vec[i].get(), change);
+            if (ledger_enable and key == OLD) { // accepted; take energies from the trial state
+                for (size_t i = 0; i < size(); i++) {
+                    if (change.all or change.dV)
+                        ledger_group[i].clear();
+                    else
+                        for (auto &d : change.groups)
+                            ledger_group[i].erase(d.index);
+                    ledger_system_valid[i] = false;
+                    if (other->last_valid.size() == size() and other->last_valid[i])
+                        record(i, change, other->last[i]);
+                }
+            }
             return;
         }
     throw std::runtime_error("hamiltonian mismatch");
 }
-void SASAEnergy::updateSASA(const SASAEnergy::Tpvec &p) {
-    assert(ps != nullptr);
-    radii.resize(p.size());
-    std::transform(p.begin(), p.end(), radii.begin(),
+void SASAEnergy::findNeighbours(int i, std::vector<int> &index) const {
+    index.clear();
+    auto overlap = [&](int j) {
+        if (j != i and spc.geo.sqdist(spc.p[i].pos, spc.p[j].pos) < std::pow(radii[i] + radii[j], 2))
+            index.push_back(j);
+    };
+    if (celllist_ready)
+        celllist.forEachNeighbor(celllist.cell(i), overlap);
+    else
+        for (int j = 0; j < int(spc.p.size()); j++)
+            if (isActive(j))
+                overlap(j);
+}
+void SASAEnergy::updateParticle(int i) {
+    if (not isupdated[i]) {
+        isupdated[i] = true;
+        updated.push_back(i);
+    }
+    sasa[i] = 0;
+    neighbours[i].clear();
+    if (not isActive(i))
+        return;
+    findNeighbours(i, neighbours[i]);
+    auto &a = atoms[spc.p[i].id];
+    if (std::fabs(a.tfe) > 1e-9 || std::fabs(a.tension) > 1e-9) {
+        if (neighbours[i].empty()) // isolated sphere
+            sasa[i] = 4 * pc::pi * radii[i] * radii[i];
+        else {
+            std::vector<Point> xyz = {Point(0, 0, 0)}; // cluster centered on `i`
+            std::vector<float> r = {radii[i]};
+            for (int j : neighbours[i]) {
+                xyz.push_back(spc.geo.vdist(spc.p[j].pos, spc.p[i].pos));
+                r.push_back(radii[j]);
+            }
+            POWERSASA::PowerSasa<float, Point> ps(xyz, r);
+            ps.calc_sasa_single(0);
+            sasa[i] = ps.getSasa()[0];
+        }
+    }
+}
+void SASAEnergy::build() {
+    size_t N = spc.p.size();
+    groupOf.assign(N, -1);
+    for (size_t k = 0; k < spc.groups.size(); k++) {
+        auto &g = spc.groups[k];
+        std::fill(groupOf.begin() + std::distance(spc.p.begin(), g.begin()),
+                  groupOf.begin() + std::distance(spc.p.begin(), g.trueend()), int(k));
+    }
+    radii.resize(N);
+    std::transform(spc.p.begin(), spc.p.end(), radii.begin(),
                    [this](auto &a) { return atoms[a.id].sigma * 0.5 + this->probe; });
 
-    ps->update_coords(spc.positions(), radii); // slowest step!
-
-    for (size_t i = 0; i < p.size(); i++) {
-        auto &a = atoms[p[i].id];
-        if (std::fabs(a.tfe) > 1e-9 || std::fabs(a.tension) > 1e-9)
-            ps->calc_sasa_single(i);
+    double cellsize = 0; // largest sphere diameter of any atom type
+    for (auto &a : atoms)
+        cellsize = std::max(cellsize, a.sigma + 2 * probe);
+    celllist_box = spc.geo.getLength();
+    celllist_ready = cellsize > 0;
+    switch (spc.geo.type) {
+    case Geometry::CUBOID:
+        pbc = {{true, true, true}};
+        break;
+    case Geometry::SLIT:
+        pbc = {{true, true, false}};
+        break;
+    case Geometry::CYLINDER:
+        pbc = {{false, false, true}};
+        break;
+    case Geometry::SPHERE:
+        pbc = {{false, false, false}};
+        break;
+    default:
+        celllist_ready = false; // neighbours are found by looping over all particles
+    }
+    for (int d = 0; d < 3; d++)
+        if (pbc[d] and celllist_box[d] < 3 * cellsize)
+            celllist_ready = false;
+    if (celllist_ready) {
+        celllist.resize(celllist_box, cellsize, pbc);
+        celllist.update(spc.p, [](auto &i) -> const Point & { return i.pos; },
+                        [this](size_t n) { return isActive(n); });
+    }
+    sasa.assign(N, 0);
+    neighbours.assign(N, std::vector<int>());
+    isupdated.assign(N, false);
+    updated.clear();
+    for (size_t i = 0; i < N; i++)
+        updateParticle(i);
+}
+void SASAEnergy::updateSASA(const Change &change) {
+    if (change.all or change.dV or groupOf.size() != spc.p.size() or spc.geo.getLength() != celllist_box) {
+        build();
+        return;
     }
-    sasa = ps->getSasa();
-    assert(sasa.size() == p.size());
+    std::vector<int> moved, affected;
+    for (auto &d : change.groups) {
+        auto &g = spc.groups.at(d.index);
+        int offset = std::distance(spc.p.begin(), g.begin());
+        if (d.all or d.dNatomic) // atomic deletions may also swap unlisted atoms
+            for (int i = 0; i < int(g.capacity()); i++)
+                moved.push_back(offset + i);
+        else
+            for (int i : d.atoms)
+                moved.push_back(offset + i);
+    }
+    for (int i : moved) { // old neighbours are found before the lists are updated
+        affected.push_back(i);
+        affected.insert(affected.end(), neighbours[i].begin(), neighbours[i].end());
+        radii[i] = atoms[spc.p[i].id].sigma * 0.5 + probe; // the atom type may have changed
+        if (celllist_ready) {
+            if (isActive(i))
+                celllist.update(i, spc.p[i].pos);
+            else
+                celllist.erase(i);
+        }
+    }
+    std::vector<int> index;
+    for (int i : moved) // new neighbours
+        if (isActive(i)) {
+            findNeighbours(i, index);
+            affected.insert(affected.end(), index.begin(), index.end());
+        }
+    std::sort(affected.begin(), affected.end());
+    affected.erase(std::unique(affected.begin(), affected.end()), affected.end());
+    for (int i : affected)
+        updateParticle(i);
 }
 void SASAEnergy::to_json(json &j) const {
     using namespace u8;
@@ -485,45 +941,63 @@ void SASAEnergy::to_json(json &j) const {
 void SASAEnergy::sync(Energybase *basePtr, Change &c) {
     auto other = dynamic_cast<decltype(this)>(basePtr);
     if (other) {
-        if (c.all || c.dV) {
+        if (c.all || c.dV || groupOf.size() != other->groupOf.size()) {
             radii = other->radii;
             sasa = other->sasa;
+            neighbours = other->neighbours;
+            groupOf = other->groupOf;
+            pbc = other->pbc;
+            celllist = other->celllist;
+            celllist_ready = other->celllist_ready;
+            celllist_box = other->celllist_box;
         } else {
-            for (auto &d : c.groups) {
-                int offset = std::distance(spc.p.begin(), spc.groups.at(d.index).begin());
-                for (int j : d.atoms) {
-                    int i = j + offset;
+            // atomic deletions swap atoms also in the accepted state which, if its energy was
+            // taken from the ledger, has not recalculated the group
+            Change swapped;
+            for (auto &d : c.groups)
+                if (d.dNatomic and not d.atoms.empty()) {
+                    int i = std::distance(spc.p.begin(), spc.groups.at(d.index).begin()) + d.atoms.front();
+                    if (not other->isupdated[i]) {
+                        swapped.groups.push_back(d);
+                        swapped.groups.back().all = true;
+                    }
+                }
+            if (not swapped.groups.empty())
+                other->updateSASA(swapped);
+            // entries that may differ were recalculated by either state since the last sync
+            for (auto *state : {this, other})
+                for (int i : state->updated) {
                     radii[i] = other->radii[i];
                     sasa[i] = other->sasa[i];
+                    neighbours[i] = other->neighbours[i];
+                    if (celllist_ready) {
+                        if (other->celllist.contains(i))
+                            celllist.update(i, spc.p[i].pos);
+                        else
+                            celllist.erase(i);
+                    }
                 }
-            }
+        }
+        for (auto *state : {this, other}) {
+            state->isupdated.assign(state->groupOf.size(), false);
+            state->updated.clear();
         }
     }
 }
 SASAEnergy::SASAEnergy(const json &j, Tspace &spc) : spc(spc) {
     name = "sasa";
     cite = "doi:10.1002/jcc.21844";
+    ledger = SYSTEM; // energy() always returns the total SASA energy
     probe = j.value("radius", 1.4) * 1.0_angstrom;
     conc = j.at("molarity").get<double>() * 1.0_molar;
     init();
 }
-void SASAEnergy::init() {
-    radii.resize(spc.p.size());
-    std::transform(spc.p.begin(), spc.p.end(), radii.begin(),
-                   [this](auto &a) { return atoms[a.id].sigma * 0.5 + this->probe; });
+void SASAEnergy::init() { build(); }
 
-    if (ps == nullptr)
-        ps = std::make_shared<POWERSASA::PowerSasa<float, Point>>(spc.positions(), radii);
-    updateSASA(spc.p);
-}
-double SASAEnergy::energy(Change &) {
+double SASAEnergy::energy(Change &change) {
     double u = 0, A = 0;
-    /*
-     * ideally we want to call `update` only if `key==NEW` but
-     * syncronising the PowerSasa object is difficult since it's
-     * non-copyable.
-     */
-    updateSASA(spc.p); // ideally we want
+    if (change)
+        updateSASA(change); // only particles overlapping moved ones
     for (size_t i = 0; i < spc.p.size(); ++i) {
         auto &a = atoms[spc.p[i].id];
         u += sasa[i] * (a.tension + conc * a.tfe);
@@ -1,7 +1,11 @@
 #pragma once
 
 #include "space.h"
+#include "celllist.h"
+#include "fft.h"
+#include "multipole.h"
 #include <Eigen/Dense>
+#include <numeric>
 
 #ifdef ENABLE_POWERSASA
 #include <power_sasa.h>
@@ -19,6 +23,9 @@ class Energybase {
   public:
     enum keys { OLD, NEW, NONE };
     keys key = NONE;
+    enum ledgers { NOLEDGER, SYSTEM, GROUP };
+    ledgers ledger = NOLEDGER; //!< How the accepted energy may be reused; see `Hamiltonian::ledgerEnergy()`
+    double umin = -pc::infty;  //!< Lower bound of `energy()`, if known; used to stop evaluations early
     std::string name;
     std::string cite;
     TimeRelativeOfTotal<std::chrono::microseconds> timer;
@@ -26,6 +33,8 @@ class Energybase {
     virtual void to_json(json &j) const; //!< json output
     virtual void sync(Energybase *, Change &);
     virtual void init();                               //!< reset and initialize
+    virtual bool hasDelta(const Change &) const;       //!< true if `delta()` can handle the change
+    virtual double delta(Change &, const Tspace &old, const Tspace &trial); //!< trial minus old energy in one pass
     virtual inline void force(std::vector<Point> &){}; // update forces on all particles
     inline virtual ~Energybase(){};
 };
@@ -40,7 +49,10 @@ void to_json(json &j, const Energybase &base); //!< Converts any energy class to
  */
 struct ContainerOverlap : public Energybase {
     const Tspace &spc;
-    ContainerOverlap(const Tspace &spc) : spc(spc) { name = "ContainerOverlap"; }
+    ContainerOverlap(const Tspace &spc) : spc(spc) {
+        name = "ContainerOverlap";
+        umin = 0;
+    }
     double energy(Change &change) override;
 };
 
@@ -50,13 +62,20 @@ struct ContainerOverlap : public Energybase {
 struct EwaldData {
     typedef std::complex<double> Tcomplex;
     Eigen::Matrix3Xd kVectors;   // k-vectors, 3xK
+    Eigen::Matrix3Xi kIndices;   // integer indices, n, of each k-vector, k = 2*pi*n/L, 3xK
     Eigen::VectorXd Aks;         // 1xK, to minimize computational effort (Eq.24,DOI:10.1063/1.481216)
     Eigen::VectorXcd Qion, Qdip; // 1xK
     double alpha, rc, kc, check_k2_zero, lB;
     double const_inf, eps_surf;
     bool spherical_sum = true;
     bool ipbc = false;
+    bool cache = false;      // cache phase factors of each particle for faster updates?
+    bool omp_enable = false; // rebuild `Qion` in parallel blocks of k-vectors?
     int kVectorsInUse = 0;
+    int nmax = 0;  // largest absolute index in `kIndices`
+    int mesh = 0;  // PME grid points in each dimension (0 = automatic)
+    int order = 4; // PME B-spline order
+    json tuning;   // input and result of automatic parameters, see `tuneEwald()`
     Point L; //!< Box dimensions
 
     void update(const Point &box);
@@ -66,6 +85,61 @@ void from_json(const json &j, EwaldData &d);
 
 void to_json(json &j, const EwaldData &d);
 
+/*
+ * Error estimates of the total energy (Kolafa and Perram, Mol. Simul. 9, 351, 1992) in units
+ * of e^2/angstrom, for charges with sum of squares `Q2`. `kc` is the largest integer k-vector
+ * index and `L` the box length.
+ */
+double ewaldRealError(double Q2, double alpha, double rc, double V);    //!< Estimated real space energy error
+double ewaldReciprocalError(double Q2, double alpha, double kc, double L); //!< Estimated reciprocal energy error
+
+/**
+ * @brief Set Ewald `alpha`, `cutoff` and `kcutoff` for a target accuracy at minimum cost
+ *
+ * The json object `auto` must contain `accuracy`, the allowed energy error in kT, which is
+ * split evenly between real and reciprocal space. For each real space cutoff up to half the
+ * shortest box side, the smallest `alpha` and `kcutoff` meeting the accuracy are found and the
+ * combination with the lowest cost of moving a single particle is chosen. This cost is the
+ * number of pairs within the cutoff, weighted by `paircost`, plus the number of k-vectors.
+ * `paircost` is the time of one real space pair relative to one k-vector. It defaults to one, or
+ * is measured if `benchmark` is true. The chosen values and predicted errors are stored in `auto`.
+ *
+ * @param j Coulomb input with an `auto` section; modified in place
+ * @param box Box side lengths
+ * @param N Number of charged particles
+ * @param Q2 Sum of squared charges
+ */
+void tuneEwald(json &j, const Point &box, int N, double Q2);
+
+#ifdef DOCTEST_LIBRARY_INCLUDED
+TEST_CASE("[Faunus] Ewald - tuning") {
+    using doctest::Approx;
+    json j = R"({"type": "ewald", "epsr": 80, "auto": {"accuracy": 1e-5}})"_json;
+    Point box(40, 40, 40);
+    tuneEwald(j, box, 200, 200);
+    double lB = pc::lB(80);
+    CHECK(j.at("cutoff").get<double>() <= 20);
+    CHECK(lB * ewaldRealError(200, j.at("alpha"), j.at("cutoff"), box.prod()) <= Approx(1e-5 / std::sqrt(2)));
+    CHECK(lB * ewaldReciprocalError(200, j.at("alpha"), j.at("kcutoff"), 40) <= Approx(1e-5 / std::sqrt(2)));
+    CHECK(j.at("auto").at("real error").get<double>() <= Approx(1e-5 / std::sqrt(2)));
+    CHECK(j.at("auto").at("reciprocal error").get<double>() <= Approx(1e-5 / std::sqrt(2)));
+
+    // shorter cutoff and more k-vectors if pairs are expensive
+    json j2 = R"({"type": "ewald", "epsr": 80, "auto": {"accuracy": 1e-5, "paircost": 100}})"_json;
+    tuneEwald(j2, box, 200, 200);
+    CHECK(j2.at("cutoff").get<double>() < j.at("cutoff").get<double>());
+    CHECK(j2.at("kcutoff").get<double>() > j.at("kcutoff").get<double>());
+
+    // parameters are read by EwaldData
+    EwaldData data = j;
+    CHECK(data.tuning.at("accuracy") == 1e-5);
+    CHECK(data.alpha == j.at("alpha").get<double>());
+
+    json j3 = R"({"type": "ewald", "epsr": 80, "auto": {"accuracy": 0}})"_json;
+    CHECK_THROWS(tuneEwald(j3, box, 200, 200));
+}
+#endif
+
 #ifdef DOCTEST_LIBRARY_INCLUDED
 TEST_CASE("[Faunus] Ewald - EwaldData") {
     using doctest::Approx;
@@ -81,6 +155,11 @@ TEST_CASE("[Faunus] Ewald - EwaldData") {
     CHECK(data.alpha == 0.894427190999916);
     CHECK(data.kVectors.cols() == 2975);
     CHECK(data.Qion.size() == data.kVectors.cols());
+    CHECK(data.kIndices.cols() == data.kVectors.cols());
+    CHECK(data.nmax == 11);
+    for (int k = 0; k < data.kVectors.cols(); k++)
+        CHECK((data.kVectors.col(k) - 2 * pc::pi * data.kIndices.col(k).cast<double>().cwiseQuotient(data.L)).norm() ==
+              Approx(0));
 
     data.ipbc = true;
     data.update(Point(10, 10, 10));
@@ -90,45 +169,181 @@ TEST_CASE("[Faunus] Ewald - EwaldData") {
 #endif
 
 /** @brief recipe or policies for ion-ion ewald */
-template <bool eigenopt = false /** use Eigen matrix ops where possible */> struct PolicyIonIon {
+struct PolicyIonIon {
     typedef typename Tspace::Tpvec::iterator iter;
+    typedef typename Tspace::Tgroup Tgroup;
     Tspace *spc;
     Tspace *old = nullptr; // set only if key==NEW at first call to `sync()`
 
+    /*
+     * With `EwaldData::cache`, the phase factors exp(i*2*pi*n*r/L) of each particle slot are
+     * stored for each axis and n in [-nmax, nmax]. Contributions to `Qion` are then products
+     * of three table entries so that old positions need no trigonometric functions, new
+     * positions need one sincos per axis, and no access to the other space is required.
+     */
+    std::vector<EwaldData::Tcomplex> eik; // phase factors; 3*(2*nmax+1) per particle slot
+    std::vector<double> eik_charge;       // charge of each slot at the time of caching; zero if inactive
+    Eigen::VectorXcd dQ;                  // change in `Qion` due to touched slots, 1xK
+
     PolicyIonIon(Tspace &spc) : spc(&spc) {}
 
-    void updateComplex(EwaldData &data) const {
-        auto active = spc->activeParticles();
-        if (eigenopt)
-            if (data.ipbc == false) {
-                auto pos = asEigenMatrix(active.begin().base(), active.end().base(), &Tspace::Tparticle::pos); //  Nx3
-                auto charge =
-                    asEigenVector(active.begin().base(), active.end().base(), &Tspace::Tparticle::charge); // Nx1
-                Eigen::MatrixXd kr = pos.matrix() * data.kVectors; // Nx3 * 3xK = NxK
-                data.Qion.real() = (kr.array().cos().colwise() * charge).colwise().sum();
-                data.Qion.imag() = kr.array().sin().colwise().sum();
-                return;
+    size_t eikSize(const EwaldData &d) const { return 3 * (2 * d.nmax + 1); } //!< Phase factors per slot
+
+    void updatePhases(const EwaldData &d, size_t i, const Point &pos) {
+        const int w = 2 * d.nmax + 1;
+        auto e = eik.begin() + i * eikSize(d) + d.nmax; // n = 0 of first axis
+        for (int a = 0; a < 3; a++, e += w) {
+            double x = 2 * pc::pi * pos[a] / d.L[a];
+            EwaldData::Tcomplex e1(std::cos(x), std::sin(x));
+            e[0] = 1;
+            for (int n = 1; n <= d.nmax; n++) {
+                e[n] = e[n - 1] * e1;
+                e[-n] = std::conj(e[n]);
+            }
+        }
+    } //!< Store phase factors of particle slot `i` at position `pos`
+
+    void addPhases(const EwaldData &d, Eigen::VectorXcd &Q, size_t i, double charge) const {
+        const int w = 2 * d.nmax + 1;
+        const EwaldData::Tcomplex *x = eik.data() + i * eikSize(d) + d.nmax, *y = x + w, *z = y + w;
+        const int *n = d.kIndices.data(); // nx, ny, nz for each k
+        if (d.ipbc)
+            for (int k = 0; k < d.kIndices.cols(); k++, n += 3)
+                Q[k] += charge * x[n[0]].real() * y[n[1]].real() * z[n[2]].real();
+        else
+            for (int k = 0; k < d.kIndices.cols(); k++, n += 3)
+                Q[k] += charge * (x[n[0]] * y[n[1]] * z[n[2]]);
+    } //!< Add cached contribution of particle slot `i` to `Q`, weighted by `charge`
+
+    void updateSlot(const EwaldData &d, Eigen::VectorXcd &Q, Tgroup &g, size_t i) {
+        size_t j = std::distance(spc->p.begin(), g.begin()) + i;
+        if (eik_charge[j] != 0)
+            addPhases(d, Q, j, -eik_charge[j]); // remove old contribution
+        eik_charge[j] = 0;
+        if (i < g.size() and (g.begin() + i)->charge != 0) {
+            updatePhases(d, j, (g.begin() + i)->pos);
+            eik_charge[j] = (g.begin() + i)->charge;
+            addPhases(d, Q, j, eik_charge[j]);
+        }
+    } //!< Replace the contribution to `Q` of the i'th slot in group `g` (inactive slots contribute nothing)
+
+    template <class Tfunction> void forEachSlot(Change &change, Tfunction f) {
+        for (auto &cg : change.groups) {
+            auto &g = spc->groups.at(cg.index);
+            if (cg.all or cg.dNatomic) // slots may have been (de)activated or, on atomic deletion, swapped
+                for (size_t i = 0; i < g.capacity(); i++)
+                    f(g, i);
+            else
+                for (int i : cg.atoms)
+                    f(g, i);
+        }
+    } //!< Call `f(group, index)` for each touched particle slot
+
+    /*
+     * Atomic deletions swap a random atom with the last atom also in the
+     * accepted state, which reorders slots without changing `Qion`.
+     */
+    void refreshSlots(const EwaldData &d, Change &change) {
+        if (d.cache and change.dN) {
+            dQ.setZero(d.Qion.size()); // discarded; zero for a permutation
+            for (auto &cg : change.groups)
+                if (cg.dNatomic) {
+                    auto &g = spc->groups.at(cg.index);
+                    for (size_t i = 0; i < g.capacity(); i++)
+                        updateSlot(d, dQ, g, i);
+                }
+        }
+    } //!< Re-read cached phase factors of slots that may have been swapped in this space
+
+    void sync(const PolicyIonIon &other, const EwaldData &d, Change &change) {
+        if (d.cache) {
+            if (change.all or change.dV or eik.size() != other.eik.size()) {
+                eik = other.eik;
+                eik_charge = other.eik_charge;
+            } else
+                forEachSlot(change, [&](Tgroup &g, size_t i) {
+                    size_t j = std::distance(spc->p.begin(), g.begin()) + i;
+                    eik_charge[j] = other.eik_charge[j];
+                    std::copy_n(other.eik.begin() + j * eikSize(d), eikSize(d), eik.begin() + j * eikSize(d));
+                });
+        }
+    } //!< Copy cached phase factors of touched particles from other policy
+
+    void updateComplex(EwaldData &data) {
+        if (data.cache) {
+            eik.resize(spc->p.size() * eikSize(data));
+            eik_charge.assign(spc->p.size(), 0);
+            data.Qion.setZero();
+            for (auto &g : spc->groups)
+                for (size_t i = 0; i < g.size(); i++)
+                    updateSlot(data, data.Qion, g, i);
+            return;
+        }
+        /*
+         * Blocks of k-vectors are distributed over threads and each block streams over all
+         * particles so that neither an N x K matrix nor a reduction over threads is needed.
+         * Within a block, k-vector components are contiguous which allows vectorised sincos.
+         */
+        constexpr int blocksize = 256; // k-vectors per block; components and sums fit in L1 cache
+        std::vector<double> x, y, z, q;
+        for (auto &p : spc->activeParticles())
+            if (p.charge != 0) {
+                x.push_back(p.pos.x());
+                y.push_back(p.pos.y());
+                z.push_back(p.pos.z());
+                q.push_back(p.charge);
+            }
+        const int K = data.kVectors.cols(), N = q.size(), nblocks = (K + blocksize - 1) / blocksize;
+#pragma omp parallel for schedule(dynamic) if (data.omp_enable)
+        for (int b = 0; b < nblocks; b++) {
+            const int first = b * blocksize, n = std::min(blocksize, K - first);
+            double kx[blocksize], ky[blocksize], kz[blocksize], re[blocksize], im[blocksize];
+            for (int k = 0; k < n; k++) {
+                kx[k] = data.kVectors(0, first + k);
+                ky[k] = data.kVectors(1, first + k);
+                kz[k] = data.kVectors(2, first + k);
+                re[k] = im[k] = 0;
             }
-        for (int k = 0; k < data.kVectors.cols(); k++) {
-            const Point &kv = data.kVectors.col(k);
-            EwaldData::Tcomplex Q(0, 0);
             if (data.ipbc)
-                for (auto &i : active)
-                    Q += kv.cwiseProduct(i.pos).array().cos().prod() * i.charge;
+                for (int i = 0; i < N; i++) {
+#pragma omp simd
+                    for (int k = 0; k < n; k++)
+                        re[k] += q[i] * std::cos(kx[k] * x[i]) * std::cos(ky[k] * y[i]) * std::cos(kz[k] * z[i]);
+                }
             else
-                for (auto &i : active) {
-                    double dot = kv.dot(i.pos);
-                    Q += i.charge * EwaldData::Tcomplex(std::cos(dot), std::sin(dot));
+                for (int i = 0; i < N; i++) {
+#pragma omp simd
+                    for (int k = 0; k < n; k++) {
+                        double kr = kx[k] * x[i] + ky[k] * y[i] + kz[k] * z[i];
+                        re[k] += q[i] * std::cos(kr);
+                        im[k] += q[i] * std::sin(kr);
+                    }
                 }
-            data.Qion[k] = Q;
+            for (int k = 0; k < n; k++)
+                data.Qion[first + k] = EwaldData::Tcomplex(re[k], im[k]);
         }
     } //!< Update all k vectors
 
-    void updateComplex(EwaldData &data, Change &change) const {
+    /*
+     * The reciprocal energy change is evaluated in the same pass over k as the update
+     * of `Qion` from the change, dQ, as A_k * (2*Re(conj(Q)*dQ) + |dQ|^2)
+     */
+    double updateComplex(EwaldData &data, Change &change) {
+        double dE = 0;
+        if (data.cache) {
+            assert(eik_charge.size() == spc->p.size());
+            dQ.setZero(data.Qion.size());
+            forEachSlot(change, [&](Tgroup &g, size_t i) { updateSlot(data, dQ, g, i); });
+            for (int k = 0; k < data.Qion.size(); k++) {
+                dE += data.Aks[k] * (2 * (std::conj(data.Qion[k]) * dQ[k]).real() + std::norm(dQ[k]));
+                data.Qion[k] += dQ[k];
+            }
+            return 2 * pc::pi / spc->geo.getVolume() * dE * data.lB;
+        }
         assert(old != nullptr);
         assert(spc->p.size() == old->p.size());
         for (int k = 0; k < data.kVectors.cols(); k++) {
-            auto &Q = data.Qion[k];
+            EwaldData::Tcomplex Q(0, 0); // change in Qion[k]
             Point q = data.kVectors.col(k);
             if (data.ipbc)
                 for (auto cg : change.groups) {
@@ -158,8 +373,11 @@ template <bool eigenopt = false /** use Eigen matrix ops where possible */> stru
                         }
                     }
                 }
+            dE += data.Aks[k] * (2 * (std::conj(data.Qion[k]) * Q).real() + std::norm(Q));
+            data.Qion[k] += Q;
         }
-    } //!< Optimized update of k subset. Require access to old positions through `old` pointer
+        return 2 * pc::pi / spc->geo.getVolume() * dE * data.lB;
+    } //!< Optimized update of k subset; returns reciprocal energy change. Require access to old positions through `old` pointer or cached phases
 
     double selfEnergy(const EwaldData &d, Change &change) {
         double Eq = 0;
@@ -177,31 +395,30 @@ template <bool eigenopt = false /** use Eigen matrix ops where possible */> stru
         return -d.alpha * Eq / std::sqrt(pc::pi) * d.lB;
     }
 
-    double surfaceEnergy(const EwaldData &d, Change &change) {
+    double surfaceEnergy(const EwaldData &d, Change &change, const Tspace &s) const {
         if (d.const_inf < 0.5)
             return 0;
         Point qr(0, 0, 0);
         if (change.all or change.dV)
-            for (auto g : spc->groups)
+            for (auto g : s.groups)
                 for (auto i : g)
                     qr += i.charge * i.pos;
         else if (change.groups.size() > 0)
             for (auto cg : change.groups) {
-                auto g = spc->groups.at(cg.index);
+                auto g = s.groups.at(cg.index);
                 for (auto i : cg.atoms)
                     if (i < g.size())
                         qr += (g.begin() + i)->charge * (g.begin() + i)->pos;
             }
-        return d.const_inf * 2 * pc::pi / ((2 * d.eps_surf + 1) * spc->geo.getVolume()) * qr.dot(qr) * d.lB;
-    }
+        return d.const_inf * 2 * pc::pi / ((2 * d.eps_surf + 1) * s.geo.getVolume()) * qr.dot(qr) * d.lB;
+    } //!< Surface energy of given space
+
+    double surfaceEnergy(const EwaldData &d, Change &change) { return surfaceEnergy(d, change, *spc); }
 
     double reciprocalEnergy(const EwaldData &d) {
         double E = 0;
-        if (eigenopt) // known at compile time
-            E = d.Aks.cwiseProduct(d.Qion.cwiseAbs2()).sum();
-        else
-            for (int k = 0; k < d.Qion.size(); k++)
-                E += d.Aks[k] * std::norm(d.Qion[k]);
+        for (int k = 0; k < d.Qion.size(); k++)
+            E += d.Aks[k] * std::norm(d.Qion[k]);
         return 2 * pc::pi / spc->geo.getVolume() * E * d.lB;
     }
 };
@@ -217,7 +434,7 @@ TEST_CASE("[Faunus] Ewald - IonIonPolicy") {
     Group<Particle> g(spc.p.begin(), spc.p.end());
     spc.groups.push_back(g);
 
-    PolicyIonIon<> ionion(spc);
+    PolicyIonIon ionion(spc);
     EwaldData data = R"({
                 "epsr": 1.0, "alpha": 0.894427190999916, "epss": 1.0,
                 "kcutoff": 11.0, "spherical_sum": true, "cutoff": 5.0})"_json;
@@ -236,15 +453,241 @@ TEST_CASE("[Faunus] Ewald - IonIonPolicy") {
     CHECK(ionion.selfEnergy(data, c) == Approx(-1.0092530088080642 * data.lB));
     CHECK(ionion.surfaceEnergy(data, c) == Approx(0.0020943951023931952 * data.lB));
     CHECK(ionion.reciprocalEnergy(data) == Approx(0.0865107467 * data.lB));
+
+    // cached phase factors, also for a partial update
+    Change::data d;
+    d.index = 0;
+    d.atoms = {1};
+    Change c1;
+    c1.groups.push_back(d);
+    data.cache = true;
+    for (bool ipbc : {false, true}) {
+        data.ipbc = ipbc;
+        data.update(spc.geo.getLength());
+        ionion.updateComplex(data);
+        CHECK(ionion.reciprocalEnergy(data) == Approx((ipbc ? 0.0865107467 : 0.21303063979675319) * data.lB));
+        spc.p[1].pos = Point(0.5, 1, -2);
+        ionion.updateComplex(data, c1);
+        double u = ionion.reciprocalEnergy(data);
+        ionion.updateComplex(data); // full rebuild
+        CHECK(u == Approx(ionion.reciprocalEnergy(data)));
+        spc.p[1].pos = Point(1, 0, 0);
+    }
+
+    // reciprocal energy change from a partial update compared with the brute force sum
+    Tspace old;
+    c.all = true;
+    old.sync(spc, c);
+    ionion.old = &old;
+    for (bool cache : {false, true})
+        for (bool ipbc : {false, true}) {
+            data.cache = cache;
+            data.ipbc = ipbc;
+            data.update(spc.geo.getLength());
+            ionion.updateComplex(data);
+            double u0 = ionion.reciprocalEnergy(data);
+            spc.p[1].pos = Point(0.5, 1, -2);
+            double du = ionion.updateComplex(data, c1);
+            CHECK(du == Approx(ionion.reciprocalEnergy(data) - u0));
+            ionion.updateComplex(data); // brute force
+            CHECK(du == Approx(ionion.reciprocalEnergy(data) - u0));
+            spc.p[1].pos = Point(1, 0, 0);
+        }
+}
+#endif
+
+/**
+ * @brief Smooth particle-mesh Ewald (PME) recipe for ion-ion reciprocal space
+ *
+ * Charges are spread onto a regular grid with cardinal B-splines of order `EwaldData::order`
+ * and the structure factors of the k-vectors in `EwaldData` are found from a single FFT
+ * of the grid, corrected by the Euler exponential spline factors (doi:10.1063/1.470117).
+ * Full updates thus scale as N + M log M for M grid points instead of N times the number
+ * of k-vectors. Moves of a few particles add the separable spline contributions of the new
+ * positions and subtract those of the old so that `Qion` always matches the mesh.
+ * Self, surface and reciprocal energies are those of `PolicyIonIon`. IPBC is not supported.
+ */
+struct PolicyPME : public PolicyIonIon {
+    int mesh = 0;                          // grid points in each dimension
+    std::vector<FFT::Tcomplex> grid;       // charges on grid, then their Fourier transform
+    std::vector<FFT::Tcomplex> roots;      // exp(2*pi*i*j/mesh) for j in [0, mesh)
+    std::vector<FFT::Tcomplex> bfactor;    // Euler spline factor for n in [-nmax, nmax]
+    std::vector<FFT::Tcomplex> phases;     // spline phase factors of one particle, 3*(2*nmax+1)
+    std::vector<double> theta;             // spline weights along one axis
+
+    PolicyPME(Tspace &spc) : PolicyIonIon(spc) {}
+
+    static void splineWeights(double w, int order, double *theta) {
+        theta[0] = 1;
+        for (int k = 2; k <= order; k++) { // recursion from order k-1 to k
+            theta[k - 1] = 0;
+            for (int j = k - 1; j >= 0; j--)
+                theta[j] = ((w + j) * theta[j] + (j > 0 ? (k - w - j) * theta[j - 1] : 0)) / (k - 1);
+        }
+    } //!< Cardinal B-spline values M_order(w+j) for j in [0, order) and w in [0,1)
+
+    int wrap(int n) const { return ((n % mesh) + mesh) % mesh; } //!< Grid index in [0, mesh)
+
+    void setup(EwaldData &d) {
+        if (d.ipbc)
+            throw std::runtime_error("pme: ipbc is not supported");
+        if (d.mesh == 0) // default: twice the k-vector range
+            d.mesh = FFT::nextPowerOfTwo(2 * (2 * d.nmax + 1));
+        if (not FFT::isPowerOfTwo(d.mesh) or d.mesh < 2 * d.nmax + 2)
+            throw std::runtime_error("pme: mesh must be a power of two larger than twice the k-vector range");
+        if (d.order < 2)
+            throw std::runtime_error("pme: spline order must be at least two");
+        mesh = d.mesh;
+        roots.resize(mesh);
+        for (int j = 0; j < mesh; j++)
+            roots[j] = std::polar(1.0, 2 * pc::pi * j / mesh);
+        theta.resize(d.order);
+        splineWeights(0, d.order, theta.data()); // M(j) at integer points
+        bfactor.resize(2 * d.nmax + 1);
+        for (int n = -d.nmax; n <= d.nmax; n++) {
+            FFT::Tcomplex s(0, 0);
+            for (int j = 1; j < d.order; j++)
+                s += theta[j] * std::conj(roots[wrap(n * j)]);
+            bfactor[n + d.nmax] = 1.0 / s;
+        }
+        phases.resize(3 * (2 * d.nmax + 1));
+    } //!< Prepare grid, roots of unity and spline factors
+
+    void addParticle(const EwaldData &d, Eigen::VectorXcd &Q, const Point &pos, double charge) {
+        const int w = 2 * d.nmax + 1;
+        for (int a = 0; a < 3; a++) {
+            double u = mesh * pos[a] / d.L[a];
+            int g0 = int(std::floor(u));
+            splineWeights(u - g0, d.order, theta.data());
+            for (int n = -d.nmax; n <= d.nmax; n++) {
+                FFT::Tcomplex c(0, 0);
+                for (int j = 0; j < d.order; j++)
+                    c += theta[j] * roots[wrap(n * (g0 - j))];
+                phases[a * w + n + d.nmax] = bfactor[n + d.nmax] * c;
+            }
+        }
+        const FFT::Tcomplex *x = phases.data() + d.nmax, *y = x + w, *z = y + w;
+        const int *n = d.kIndices.data();
+        for (int k = 0; k < d.kIndices.cols(); k++, n += 3)
+            Q[k] += charge * (x[n[0]] * y[n[1]] * z[n[2]]);
+    } //!< Add mesh structure factor of a single charge to `Q`
+
+    void updateComplex(EwaldData &data) {
+        setup(data);
+        grid.assign(size_t(mesh) * mesh * mesh, 0);
+        int g[3];
+        std::vector<double> t(3 * data.order);
+        for (auto &p : spc->activeParticles()) {
+            for (int a = 0; a < 3; a++) {
+                double u = mesh * p.pos[a] / data.L[a];
+                g[a] = int(std::floor(u));
+                splineWeights(u - g[a], data.order, t.data() + a * data.order);
+            }
+            const double *tx = t.data(), *ty = tx + data.order, *tz = ty + data.order;
+            for (int i = 0; i < data.order; i++)
+                for (int j = 0; j < data.order; j++) {
+                    double qxy = p.charge * tx[i] * ty[j];
+                    size_t offset = (size_t(wrap(g[0] - i)) * mesh + wrap(g[1] - j)) * mesh;
+                    for (int k = 0; k < data.order; k++)
+                        grid[offset + wrap(g[2] - k)] += qxy * tz[k];
+                }
+        }
+        FFT::fft3(grid, mesh, mesh, mesh, 1);
+        for (int k = 0; k < data.kIndices.cols(); k++) {
+            auto n = data.kIndices.col(k);
+            data.Qion[k] = bfactor[n[0] + data.nmax] * bfactor[n[1] + data.nmax] * bfactor[n[2] + data.nmax] *
+                           grid[(size_t(wrap(n[0])) * mesh + wrap(n[1])) * mesh + wrap(n[2])];
+        }
+    } //!< Update all k vectors from the charge mesh
+
+    double updateComplex(EwaldData &data, Change &change) {
+        assert(old != nullptr);
+        assert(spc->p.size() == old->p.size());
+        dQ.setZero(data.Qion.size());
+        for (auto &cg : change.groups) {
+            auto &g_new = spc->groups.at(cg.index);
+            auto &g_old = old->groups.at(cg.index);
+            auto update = [&](size_t i) {
+                if (i < g_new.size())
+                    addParticle(data, dQ, (g_new.begin() + i)->pos, (g_new.begin() + i)->charge);
+                if (i < g_old.size())
+                    addParticle(data, dQ, (g_old.begin() + i)->pos, -(g_old.begin() + i)->charge);
+            };
+            if (cg.all)
+                for (size_t i = 0; i < g_new.capacity(); i++)
+                    update(i);
+            else
+                for (int i : cg.atoms)
+                    update(i);
+        }
+        double dE = 0;
+        for (int k = 0; k < data.Qion.size(); k++) {
+            dE += data.Aks[k] * (2 * (std::conj(data.Qion[k]) * dQ[k]).real() + std::norm(dQ[k]));
+            data.Qion[k] += dQ[k];
+        }
+        return 2 * pc::pi / spc->geo.getVolume() * dE * data.lB;
+    } //!< Update from moved particles; returns reciprocal energy change. Require access to old positions
+
+    void sync(const PolicyPME &, const EwaldData &, Change &) {} //!< Nothing is cached between moves
+    void refreshSlots(const EwaldData &, Change &) {}              //!< Nothing is cached between moves
+};
+
+#ifdef DOCTEST_LIBRARY_INCLUDED
+TEST_CASE("[Faunus] Ewald - PMEPolicy") {
+    using doctest::Approx;
+    Tspace spc;
+    spc.geo = R"( {"type": "cuboid", "length": [10, 12, 14]} )"_json;
+    spc.p.resize(6);
+    for (size_t i = 0; i < spc.p.size(); i++) {
+        Point u(std::sin(1.3 * i), std::cos(2.1 * i), std::sin(0.7 * i + 1));
+        spc.p[i].pos = 0.49 * u.cwiseProduct(spc.geo.getLength());
+        spc.p[i].charge = (i % 2 == 0) ? 1.0 : -1.0;
+    }
+    spc.groups.push_back(Group<Particle>(spc.p.begin(), spc.p.end()));
+
+    EwaldData data = R"({"epsr": 1.0, "alpha": 0.894427190999916, "epss": 1.0,
+                         "kcutoff": 11.0, "spherical_sum": true, "cutoff": 5.0, "order": 6})"_json;
+    data.update(spc.geo.getLength());
+    PolicyIonIon ionion(spc);
+    PolicyPME pme(spc);
+    ionion.updateComplex(data);
+    double u_exact = ionion.reciprocalEnergy(data);
+    pme.updateComplex(data);
+    CHECK(data.mesh == 64);
+    CHECK(pme.reciprocalEnergy(data) == Approx(u_exact).epsilon(1e-5));
+
+    // moving a particle
+    Tspace old;
+    Change c;
+    c.all = true;
+    old.sync(spc, c);
+    pme.old = &old;
+    Change::data d;
+    d.index = 0;
+    d.atoms = {3};
+    c.clear();
+    c.groups.push_back(d);
+    spc.p[3].pos = Point(0.5, -4, 3);
+    double du = pme.updateComplex(data, c);
+    double u = pme.reciprocalEnergy(data);
+    pme.updateComplex(data); // from scratch
+    CHECK(u == Approx(pme.reciprocalEnergy(data)));
+    ionion.updateComplex(data);
+    CHECK(du == Approx(ionion.reciprocalEnergy(data) - u_exact).epsilon(1e-4));
+
+    data.ipbc = true;
+    CHECK_THROWS(pme.updateComplex(data));
 }
 #endif
 
 /** @brief Ewald summation reciprocal energy */
-template <class Policy = PolicyIonIon<>> class Ewald : public Energybase {
+template <class Policy = PolicyIonIon> class Ewald : public Energybase {
   private:
     EwaldData data;
     Policy policy;
     Tspace &spc;
+    double ureciprocal = 0;        // reciprocal energy of current `data`
+    bool ureciprocal_ready = false; // true if `ureciprocal` matches `data`
 
   public:
     Ewald(const json &j, Tspace &spc) : policy(spc), spc(spc) {
@@ -256,6 +699,7 @@ template <class Policy = PolicyIonIon<>> class Ewald : public Energybase {
     void init() override {
         data.update(spc.geo.getLength());
         policy.updateComplex(data); // brute force. todo: be selective
+        ureciprocal_ready = false;
     }
 
     double energy(Change &change) override {
@@ -268,26 +712,154 @@ template <class Policy = PolicyIonIon<>> class Ewald : public Energybase {
                     policy.updateComplex(data); // update all (expensive!)
                 } else {
                     if (change.groups.size() > 0)
-                        policy.updateComplex(data, change);
+                        ureciprocal += policy.updateComplex(data, change); // energy change fused with update
                 }
+            } else
+                policy.refreshSlots(data, change);
+            // both states start from the accepted reciprocal energy, copied in `sync()`
+            if (change.all or change.dV or not ureciprocal_ready) {
+                ureciprocal = policy.reciprocalEnergy(data);
+                ureciprocal_ready = true;
             }
-            u = policy.surfaceEnergy(data, change) + policy.reciprocalEnergy(data) + policy.selfEnergy(data, change);
+            u = policy.surfaceEnergy(data, change) + ureciprocal + policy.selfEnergy(data, change);
+            if (change.dV and key != NEW) // volume may be scaled and restored without a sync, see `VirtualVolume`
+                ureciprocal_ready = false;
         }
         return u;
     }
 
-    void sync(Energybase *basePtr, Change &) override {
+    bool hasDelta(const Change &change) const override {
+        return ureciprocal_ready and not(change.all or change.dV or change.dN) and not change.groups.empty();
+    }
+
+    double delta(Change &change, const Tspace &oldspc, const Tspace &trialspc) override {
+        double du = policy.updateComplex(data, change); // as for the trial state in `energy()`
+        ureciprocal += du;
+        return du + policy.surfaceEnergy(data, change, trialspc) - policy.surfaceEnergy(data, change, oldspc);
+    } //!< Reciprocal and surface energy change; self energies are unaffected without `dN`
+
+    void sync(Energybase *basePtr, Change &change) override {
         auto other = dynamic_cast<decltype(this)>(basePtr);
         assert(other);
         if (other->key == OLD)
             policy.old = &(other->spc); // give NEW access to OLD space for optimized updates
         data = other->data;             // copy everything!
+        policy.sync(other->policy, data, change);
+        ureciprocal = other->ureciprocal;
+        ureciprocal_ready = other->ureciprocal_ready;
 
     } //!< Called after a move is rejected/accepted as well as before simulation
 
     void to_json(json &j) const override { j = data; }
 };
 
+#ifdef DOCTEST_LIBRARY_INCLUDED
+TEST_CASE("[Faunus] Ewald - energy change") {
+    using doctest::Approx;
+    Tspace spc1, spc2; // old and trial states
+    spc1.p.resize(2);
+    spc1.geo = R"( {"type": "cuboid", "length": 10} )"_json;
+    spc1.p[0] = R"( {"pos": [0,0,0], "q": 1.0} )"_json;
+    spc1.p[1] = R"( {"pos": [1,0,0], "q": -1.0} )"_json;
+    spc1.groups.push_back(Group<Particle>(spc1.p.begin(), spc1.p.end()));
+    Change all;
+    all.all = true;
+
+    Change::data d;
+    d.index = 0;
+    d.atoms = {1};
+    Change change;
+    change.groups.push_back(d);
+
+    json j = R"({"epsr": 1.0, "alpha": 0.894427190999916, "epss": 1.0, "kcutoff": 11.0, "cutoff": 5.0})"_json;
+    for (bool cache : {false, true}) {
+        j["cache"] = cache;
+        spc2.sync(spc1, all);
+        Ewald<> ewald1(j, spc1), ewald2(j, spc2);
+        ewald1.key = Energybase::OLD;
+        ewald2.key = Energybase::NEW;
+        ewald2.sync(&ewald1, all);
+        double u1 = ewald1.energy(all);
+        ewald2.sync(&ewald1, all);
+        CHECK(ewald2.energy(all) == Approx(u1));
+        CHECK(ewald2.hasDelta(change));
+
+        spc2.p[1].pos = Point(0.5, 1, -2);
+        double du = ewald2.delta(change, spc1, spc2);
+        double uold = ewald1.energy(change); // from the stored reciprocal energy
+        Ewald<> brute(j, spc2);              // everything from scratch
+        CHECK(du == Approx(brute.energy(change) - uold));
+
+        // the accepted state takes the updated reciprocal energy in `sync()`
+        ewald1.sync(&ewald2, change);
+        spc1.sync(spc2, change);
+        CHECK(ewald1.energy(change) == Approx(brute.energy(change)));
+    }
+
+    // atomic deletion as in speciation: a random atom is swapped with the last atom
+    // in both states, and only the deactivated slot is listed in the change
+    j["cache"] = true;
+    j["epss"] = 0; // no surface energy which is evaluated for listed atoms only
+    Change deletion;
+    deletion.dN = true;
+    d.internal = true;
+    d.dNatomic = true;
+    d.atoms = {2};
+    deletion.groups.push_back(d);
+    for (bool accept : {true, false}) {
+        Tspace spc3, spc4; // old and trial states
+        spc3.geo = spc1.geo;
+        spc3.p.resize(3);
+        spc3.p[0] = R"( {"pos": [0,0,0], "q": 1.0} )"_json;
+        spc3.p[1] = R"( {"pos": [1,0,0], "q": -1.0} )"_json;
+        spc3.p[2] = R"( {"pos": [0,2,1], "q": 0.5} )"_json;
+        spc3.groups.push_back(Group<Particle>(spc3.p.begin(), spc3.p.end()));
+        spc4.sync(spc3, all);
+        Ewald<> ewald3(j, spc3), ewald4(j, spc4);
+        ewald3.key = Energybase::OLD;
+        ewald4.key = Energybase::NEW;
+        ewald4.sync(&ewald3, all);
+
+        for (auto spc : {&spc3, &spc4})
+            std::iter_swap(spc->p.begin(), spc->p.end() - 1);
+        auto &g = spc4.groups.front();
+        g.deactivate(g.end() - 1, g.end());
+        double du = ewald4.energy(deletion) - ewald3.energy(deletion);
+        Ewald<> brute3(j, spc3), brute4(j, spc4);
+        CHECK(du == Approx(brute4.energy(all) - brute3.energy(all)));
+
+        if (accept) {
+            spc3.sync(spc4, deletion);
+            ewald3.sync(&ewald4, deletion);
+        } else {
+            spc4.sync(spc3, deletion);
+            ewald4.sync(&ewald3, deletion);
+        }
+
+        // move the swapped atom; cached phase factors must follow the swap in both states
+        Change move;
+        move.groups.resize(1);
+        move.groups[0].index = 0;
+        move.groups[0].atoms = {0};
+        double uold = Ewald<>(j, spc4).energy(all);
+        spc4.p[0].pos = Point(1, 1, -1);
+        du = ewald4.energy(move) - ewald3.energy(move);
+        CHECK(du == Approx(Ewald<>(j, spc4).energy(all) - uold));
+    }
+
+    // old state at a temporarily scaled volume, as in virtual volume analysis
+    Change dV;
+    dV.dV = true;
+    Ewald<> ewald(j, spc1);
+    ewald.key = Energybase::OLD;
+    double u = ewald.energy(change), V = spc1.geo.getVolume();
+    spc1.scaleVolume(1.2 * V);
+    CHECK(ewald.energy(dV) != Approx(u));
+    spc1.scaleVolume(V);
+    CHECK(ewald.energy(change) == Approx(u));
+}
+#endif
+
 /** @brief Self-energy term of electrostatic potentials  */
 class SelfEnergy : public Energybase {
   private:
@@ -327,46 +899,508 @@ class Constrain : public Energybase {
     void to_json(json &j) const override;
 };
 
-/*
- * The keys of the `intra` map are group index and the values
- * is a vector of `BondData`. For bonds between groups, fill
- * in `inter` which is evaluated for every update of call to
- * `energy`.
+/**
+ * @brief Bonded interactions
  *
- * @todo Optimize.
+ * Intra-molecular bonds are taken from the molecule topologies while
+ * bonds between groups are given by `bondlist`, using absolute particle indices.
+ * All bonds are stored in one flat vector with a compressed sparse row (CSR)
+ * index from particle to bonds so that partial moves evaluate only bonds touching
+ * the moved particles. The index refers to particle slots and is therefore unaffected
+ * by (de)activation of groups; a bond contributes only if all its particles are active.
  */
 class Bonded : public Energybase {
   private:
     Tspace &spc;
     typedef typename Tspace::Tpvec Tpvec;
     typedef std::vector<std::shared_ptr<Potential::BondData>> BondVector;
-    BondVector inter;                // inter-molecular bonds
-    std::map<int, BondVector> intra; // intra-molecular bonds
+    BondVector bonds;                 // intra-molecular bonds (contiguous per group) followed by inter-molecular
+    std::vector<int> bond_group;      // group index of each intra-molecular bond; -1 for inter-molecular
+    std::vector<int> group_of;        // group index of each particle slot
+    std::vector<int> csr_offset;      // bonds of particle i are `csr_bonds[csr_offset[i]:csr_offset[i+1]]`
+    std::vector<int> csr_bonds;       // bond indices ordered by particle
+    std::vector<unsigned int> visited; // stamp of last visit for each bond
+    unsigned int stamp = 0;
+    std::vector<int> touched;         // bonds affected by the current change
 
   private:
-    void update_intra();                              // finds and adds all intra-molecular bonds of active molecules
-    double sum_energy(const BondVector &bonds) const; // sum energy in vector of BondData
-    double sum_energy(const BondVector &bonds, const std::vector<int> &particles_ndx)
-        const; // sum energy in vector of BondData for matching particle indices
+    void build_index(const BondVector &inter); // collects all bonds and builds the particle to bond index
+    bool is_active(int k) const;               // true if all particles of bond `k` are active
+    const std::vector<int> &touched_bonds(const Change &change); // bonds touching moved particles
+
+    const Tspace *old_spc = nullptr; // space to which `bonds_old` is bound
+    BondVector bonds_old;            // copy of `bonds` evaluated in the old space
+    void bind_old(const Tspace &old); // (re)binds copies of all bonds to particles in `old`
 
   public:
     Bonded(const json &j, Tspace &spc);
     void to_json(json &j) const override;
-    double energy(Change &change) override; // brute force -- refine this!
+    double energy(Change &change) override;
+    bool hasDelta(const Change &change) const override;
+    double delta(Change &change, const Tspace &old, const Tspace &trial) override;
 };
 
 /**
  * @brief Nonbonded energy using a pair-potential
+ *
+ * If the pair-potential vanishes beyond a finite distance, `rmax`,
+ * interaction partners of moved particles can be found via a cell list
+ * (`celllist=true`) in cuboid, slit, cylinder, and sphere geometries.
+ * The list is kept up-to-date from the `Change` object in both `energy()`
+ * and `sync()` so that single particle moves scale with the number of
+ * neighbours rather than with the system size.
+ *
+ * With `bounding=true`, each group carries a bounding sphere about its mass
+ * center, refreshed for changed groups. Molecule pairs further apart than
+ * the sum of radii plus `rmax` are skipped. Atoms of atomic groups are sorted into spatial
+ * blocks so that only blocks overlapping a molecule's sphere are visited.
+ *
+ * With `multipole`, rigid molecules further apart than a given mass center
+ * distance interact via their cached charge, dipole, and quadrupole moments
+ * instead of the atom-atom sum. Moments are refreshed for changed groups only,
+ * and every `sample`th expansion is compared with the exact sum.
  */
 template <typename Tpairpot> class Nonbonded : public Energybase {
   private:
     double g2gcnt = 0, g2gskip = 0;
     PairMatrix<double> cutoff2; // matrix w. group-to-group cutoff
 
+    bool celllist_enable = false;   // use cell list to find interaction partners?
+    bool celllist_ready = false;    // false if the box is too small for the cell list
+    CellList<> celllist;            // particle index in cells
+    Point celllist_box = {0, 0, 0}; // box dimensions for which the cell list was built
+    std::array<bool, 3> pbc = {{true, true, true}};        // periodic directions
+    std::vector<int> groupOf;                                 // group index of each particle
+    std::vector<char> ismoved;                                // flags particles in the current change
+
+    bool arrays_enable = false; // loop over structure-of-arrays particle copy, `Space::arrays`?
+
+    struct BoundingSphere {
+        Point center = {0, 0, 0};
+        double radius = 0;
+    };
+    bool bounding_enable = false;          // screen groups using bounding spheres?
+    std::vector<BoundingSphere> bounding;  // bounding sphere of each group
+    double bounding_max = pc::infty;       // largest reach for which minimum image distances are safe
+    bool blocks_ready = false;             // false if the box is too small for atom blocks
+    CellList<> blocks;                     // atoms of atomic groups in spatial blocks
+    Point blocks_box = {0, 0, 0};          // box dimensions for which the blocks were built
+
+    struct Moments {
+        double charge = 0;     // monopole
+        Point mu = {0, 0, 0};  // dipole moment about mass center
+        Tensor Q;              // quadrupole moment about mass center (with trace)
+    };
+    bool multipole_enable = false;        // expand interactions between distant rigid molecules?
+    double multipole_cutoff2 = pc::infty; // squared mass center distance beyond which to expand
+    double multipole_lB = 0;              // Bjerrum length of the expansion
+    unsigned int multipole_sample = 0;    // compare every nth expansion with the exact sum; 0 = never
+    std::vector<Moments> moments;         // multipole moments of each group
+    unsigned long multipole_cnt = 0;      // number of expanded group pairs
+    Average<double> multipole_error;      // expanded minus exact energy (kT)
+    Average<double> multipole_exact;      // exact energy of sampled pairs (kT)
+
+    bool early = false;       // true if pair sums may stop when reaching `ustop`
+    double ustop = pc::infty; // energy at which to stop; see `Change::umax`
+    inline bool stop(double u) const { return early and u >= ustop; }
+
+    double skin = 0;                      // Verlet skin; zero if Verlet lists are not used
+    std::vector<std::vector<int>> verlet; // Verlet neighbour list of each particle
+    std::vector<Point> verlet_ref;        // particle positions when their list was last built
+    unsigned long verlet_rebuilds = 0;    // number of single particle list rebuilds
+
+    void groupOfBuild() {
+        groupOf.assign(spc.p.size(), -1);
+        for (size_t k = 0; k < spc.groups.size(); k++) {
+            auto &g = spc.groups[k];
+            std::fill(groupOf.begin() + std::distance(spc.p.begin(), g.begin()),
+                      groupOf.begin() + std::distance(spc.p.begin(), g.trueend()), int(k));
+        }
+    } //!< Group index of each particle
+
+    void celllistBuild() {
+        celllist_box = spc.geo.getLength();
+        groupOfBuild();
+        ismoved.assign(spc.p.size(), 0);
+        double cellsize = std::sqrt(rcut2) + skin;
+        celllist_ready = true;
+        for (int d = 0; d < 3; d++)
+            if (pbc[d] and celllist_box[d] < 3 * cellsize)
+                celllist_ready = false;
+        if (celllist_ready) {
+            celllist.resize(celllist_box, cellsize, pbc);
+            celllist.update(spc.p, [](auto &i) -> const Point & { return i.pos; },
+                            [this](size_t n) { return isActive(n); });
+            if (skin > 0) { // build all Verlet lists using the half-shell stencil
+                double rlist2 = cellsize * cellsize;
+                verlet.assign(spc.p.size(), std::vector<int>());
+                verlet_ref.resize(spc.p.size());
+                std::transform(spc.p.begin(), spc.p.end(), verlet_ref.begin(), [](auto &i) { return i.pos; });
+                celllist.forEachPair([&](int n, int m) {
+                    if (spc.geo.sqdist(verlet_ref[n], verlet_ref[m]) < rlist2) {
+                        verlet[n].push_back(m);
+                        verlet[m].push_back(n);
+                    }
+                });
+            }
+        }
+    } //!< Rebuild cell list and Verlet lists from scratch (complexity: N)
+
+    void verletRemove(int n) {
+        for (int m : verlet[n]) {
+            auto &v = verlet[m];
+            auto it = std::find(v.begin(), v.end(), n);
+            assert(it != v.end());
+            *it = v.back();
+            v.pop_back();
+        }
+        verlet[n].clear();
+        celllist.erase(n);
+    } //!< Remove particle `n` from all Verlet lists and from the cell list
+
+    void verletRebuild(int n) {
+        double rlist2 = std::pow(std::sqrt(rcut2) + skin, 2);
+        verletRemove(n);
+        verlet_ref[n] = spc.p[n].pos;
+        celllist.insert(n, verlet_ref[n]);
+        celllist.forEachNeighbor(celllist.cell(n), [&](int m) {
+            if (m != n and spc.geo.sqdist(verlet_ref[n], verlet_ref[m]) < rlist2) {
+                verlet[n].push_back(m);
+                verlet[m].push_back(n);
+            }
+        });
+        verlet_rebuilds++;
+    } //!< Rebuild Verlet list of particle `n` at its current position
+
+    /*
+     * The cell list holds the reference positions used to build the Verlet
+     * lists and pairs are listed if their reference positions are closer than
+     * `rmax+skin`. Using reference positions for both particles, a
+     * list stays valid as long as no particle moved more than skin/2 since
+     * its own list was built.
+     */
+    void verletUpdate(int n, bool active) {
+        if (not active) {
+            if (celllist.contains(n))
+                verletRemove(n);
+        } else if (not celllist.contains(n) or spc.geo.sqdist(spc.p[n].pos, verlet_ref[n]) > 0.25 * skin * skin)
+            verletRebuild(n);
+    } //!< Lazily rebuild Verlet list of particle `n` if it moved more than skin/2
+
+    template <typename Tfunc> inline void forEachPartner(int n, Tfunc f) {
+        if (skin > 0) {
+            for (int m : verlet[n])
+                f(m);
+        } else
+            celllist.forEachNeighbor(celllist.cell(n), [&](int m) {
+                if (m != n)
+                    f(m);
+            });
+    } //!< Call `f(m)` for all possible interaction partners, `m`, of particle `n`
+
+    void celllistUpdate(const Change &change) {
+        if (change.all or change.dV or groupOf.size() != spc.p.size() or spc.geo.getLength() != celllist_box)
+            celllistBuild();
+        else if (celllist_ready)
+            for (auto &d : change.groups) {
+                auto &g = spc.groups.at(d.index);
+                int offset = std::distance(spc.p.begin(), g.begin());
+                int active = g.size();
+                auto refresh = [&](int i) {
+                    if (skin > 0)
+                        verletUpdate(offset + i, i < active);
+                    else if (i < active)
+                        celllist.update(offset + i, spc.p[offset + i].pos);
+                    else
+                        celllist.erase(offset + i);
+                };
+                if (d.all or d.dNatomic) // atomic deletions may also swap unlisted atoms
+                    for (int i = 0; i < int(g.capacity()); i++)
+                        refresh(i);
+                else
+                    for (int i : d.atoms)
+                        refresh(i);
+            }
+    } //!< Update cell list for particles touched by `change` (complexity: touched particles)
+
+    inline bool isActive(int n) const {
+        return groupOf[n] >= 0 and spc.p.begin() + n < spc.groups[groupOf[n]].end();
+    }
+
+    inline bool celllistCut(int gi, int gj) const {
+        auto &g1 = spc.groups[gi];
+        auto &g2 = spc.groups[gj];
+        return not(g1.atomic or g2.atomic) and
+               (spc.geo.sqdist(g1.cm, g2.cm) >= cutoff2(g1.id, g2.id) or boundingCut(g1, g2));
+    } //!< Group-to-group cut-off as in `cut()`, but without counting
+
+    void boundingSphere(int k) {
+        auto &g = spc.groups[k];
+        auto &s = bounding[k];
+        s.center = g.cm;
+        s.radius = 0;
+        if (not g.atomic) {
+            for (auto &a : g)
+                s.radius = std::max(s.radius, spc.geo.sqdist(a.pos, s.center));
+            s.radius = std::sqrt(s.radius);
+        }
+    } //!< Refresh bounding sphere of group `k` (complexity: group size)
+
+    void boundingBuild() {
+        groupOfBuild();
+        blocks_box = spc.geo.getLength();
+        bounding.resize(spc.groups.size());
+        for (size_t k = 0; k < spc.groups.size(); k++)
+            boundingSphere(k);
+        bounding_max = pc::infty;
+        for (int d = 0; d < 3; d++)
+            if (pbc[d])
+                bounding_max = std::min(bounding_max, 0.5 * blocks_box[d]);
+
+        size_t natoms = 0; // number of atoms in atomic groups
+        for (auto &g : spc.groups)
+            if (g.atomic)
+                natoms += g.capacity();
+        blocks_ready = natoms > 0;
+        if (blocks_ready) { // blocks of on average 16 atoms, but no smaller than `rmax`
+            double width = std::max(std::sqrt(rcut2), std::cbrt(16 * spc.geo.getVolume() / natoms));
+            for (int d = 0; d < 3; d++)
+                if (pbc[d] and blocks_box[d] < 3 * width)
+                    blocks_ready = false;
+            if (blocks_ready) {
+                blocks.resize(blocks_box, width, pbc);
+                auto include = [this](size_t n) {
+                    return groupOf[n] >= 0 and spc.groups[groupOf[n]].atomic and isActive(n);
+                };
+                blocks.update(spc.p, [](auto &i) -> const Point & { return i.pos; }, include);
+            }
+        }
+    } //!< Rebuild all bounding spheres and atom blocks (complexity: N)
+
+    void boundingUpdate(const Change &change) {
+        if (not bounding_enable)
+            return;
+        if (change.all or change.dV or bounding.size() != spc.groups.size() or spc.geo.getLength() != blocks_box)
+            boundingBuild();
+        else
+            for (auto &d : change.groups) {
+                auto &g = spc.groups.at(d.index);
+                boundingSphere(d.index);
+                if (g.atomic and blocks_ready) {
+                    int offset = std::distance(spc.p.begin(), g.begin());
+                    auto refresh = [&](int i) {
+                        if (i < int(g.size()))
+                            blocks.update(offset + i, spc.p[offset + i].pos);
+                        else
+                            blocks.erase(offset + i);
+                    };
+                    if (d.all or d.dNatomic) // atomic deletions may also swap unlisted atoms
+                        for (int i = 0; i < int(g.capacity()); i++)
+                            refresh(i);
+                    else
+                        for (int i : d.atoms)
+                            refresh(i);
+                }
+            }
+    } //!< Update bounding spheres and atom blocks for groups touched by `change`
+
+    template <typename T> inline int groupIndex(const T &g) const {
+        if (not spc.groups.empty() and &g >= &spc.groups.front() and &g <= &spc.groups.back())
+            return &g - &spc.groups.front();
+        return -1;
+    } //!< Index of group `g` in `spc`; -1 if unknown, e.g. for groups of the old state in `delta()`
+
+    template <typename T> inline int boundingIndex(const T &g) const {
+        return bounding_enable ? groupIndex(g) : -1;
+    } //!< Index of group `g` in `spc` if bounding spheres are enabled; otherwise -1
+
+    template <typename T> inline bool boundingCut(const T &g1, const T &g2) const {
+        int i = boundingIndex(g1), j = boundingIndex(g2);
+        if (i >= 0 and j >= 0 and not(g1.atomic or g2.atomic)) {
+            double reach = bounding[i].radius + bounding[j].radius + std::sqrt(rcut2);
+            return reach < bounding_max and spc.geo.sqdist(bounding[i].center, bounding[j].center) >= reach * reach;
+        }
+        return false;
+    } //!< True if no particle pair of the two molecules is within `rmax`
+
+    inline bool boundingCut(const Point &pos, int k) const {
+        if (bounding_enable and not spc.groups[k].atomic) {
+            double reach = bounding[k].radius + std::sqrt(rcut2);
+            return reach < bounding_max and spc.geo.sqdist(pos, bounding[k].center) >= reach * reach;
+        }
+        return false;
+    } //!< True if a particle at `pos` cannot interact with molecule `k`
+
+    template <typename Tfunc> void forEachNearAtom(const typename Tspace::Tgroup &atomic, int k, Tfunc f) const {
+        auto &s = bounding[k];
+        double reach = s.radius + std::sqrt(rcut2), reach2 = reach * reach;
+        int first = std::distance(spc.p.begin(), atomic.begin()), last = first + atomic.size();
+        auto near = [&](int n) {
+            if (n >= first and n < last and spc.geo.sqdist(spc.p[n].pos, s.center) < reach2)
+                f(n);
+        };
+        if (blocks_ready and reach < bounding_max) {
+            Point r = {reach, reach, reach};
+            blocks.forEachInBox(s.center - r, s.center + r, near);
+        } else
+            for (int n = first; n < last; n++)
+                near(n);
+    } //!< Call `f(n)` for all active atoms, `n`, of an atomic group within `rmax` of the sphere of molecule `k`
+
+    /*
+     * Energy between an atomic group and a molecule, `g1` and `g2` in either order,
+     * visiting only atoms near the molecule's bounding sphere. If `index` is given,
+     * only this subset of `g1` is included, as in `g2g()`.
+     */
+    double g2gAtomic(const typename Tspace::Tgroup &g1, const typename Tspace::Tgroup &g2, const std::vector<int> &index) {
+        const auto &atomic = g1.atomic ? g1 : g2;
+        const auto &molecule = g1.atomic ? g2 : g1;
+        int k = boundingIndex(molecule);
+        double u = 0;
+        if (index.empty())
+            forEachNearAtom(atomic, k, [&](int n) {
+                if (not stop(u))
+                    u += i2group(spc.p[n], molecule);
+            });
+        else if (g1.atomic) {
+            for (auto i : index) {
+                auto &a = *(g1.begin() + i);
+                if (not stop(u) and not boundingCut(a.pos, k))
+                    u += i2group(a, molecule);
+            }
+        } else {
+            std::vector<int> near;
+            forEachNearAtom(atomic, k, [&](int n) { near.push_back(n); });
+            for (auto i = index.begin(); i != index.end() and not stop(u); ++i)
+                for (int n : near)
+                    u += i2i(*(g1.begin() + *i), spc.p[n]);
+        }
+        return u;
+    }
+
+    Moments multipoleMoments(const typename Tspace::Tgroup &g) const {
+        Moments m;
+        for (auto &a : g) {
+            Point t = spc.geo.vdist(a.pos, g.cm);
+            m.charge += a.charge;
+            m.mu += a.charge * t;
+            m.Q += 0.5 * a.charge * t * t.transpose();
+        }
+        return m;
+    } //!< Charge, dipole, and quadrupole moments about the mass center of `g`
+
+    void multipoleUpdate(const Change &change) {
+        if (not multipole_enable)
+            return;
+        if (change.all or change.dV or moments.size() != spc.groups.size()) {
+            moments.resize(spc.groups.size());
+            for (size_t k = 0; k < spc.groups.size(); k++)
+                moments[k] = multipoleMoments(spc.groups[k]);
+        } else
+            for (auto &d : change.groups)
+                moments.at(d.index) = multipoleMoments(spc.groups.at(d.index));
+    } //!< Refresh moments of groups touched by `change`; rigid moments thereby follow rotations
+
+    template <typename T> inline bool multipoleFar(const T &g1, const T &g2) const {
+        return multipole_enable and not(g1.atomic or g2.atomic) and molecules[g1.id].rigid and
+               molecules[g2.id].rigid and g1.size() == g1.capacity() and g2.size() == g2.capacity() and
+               spc.geo.sqdist(g1.cm, g2.cm) >= multipole_cutoff2;
+    } //!< True if the interaction between two whole, rigid molecules should be expanded
+
+    /*
+     * Interaction between two charge distributions, `a` and `b`, truncated after the
+     * 1/r^3 terms: charge-charge, charge-dipole, dipole-dipole, and charge-quadrupole.
+     * `r` is the distance vector between mass centers, `b` to `a`.
+     */
+    double multipoleEnergy(const Moments &a, const Moments &b, const Point &r) const {
+        return multipole_lB * (a.charge * b.charge / r.norm() + q2mu(a.charge, b.mu, b.charge, a.mu, r) +
+                               mu2mu(a.mu, b.mu, 1.0, r) + q2quad(a.charge, b.Q, b.charge, a.Q, r));
+    }
+
+    double g2gMultipole(const typename Tspace::Tgroup &g1, const typename Tspace::Tgroup &g2) {
+        int i = groupIndex(g1), j = groupIndex(g2);
+        double u = multipoleEnergy(i >= 0 ? moments[i] : multipoleMoments(g1),
+                                   j >= 0 ? moments[j] : multipoleMoments(g2), spc.geo.vdist(g1.cm, g2.cm));
+        unsigned long n; // running count; `g2g()` may be called from parallel loops
+#pragma omp atomic capture
+        n = ++multipole_cnt;
+        if (multipole_sample > 0 and n % multipole_sample == 0) {
+            double exact = 0;
+            for (auto &a : g1)
+                for (auto &b : g2)
+                    exact += i2i(a, b);
+#pragma omp critical
+            {
+                multipole_error += u - exact;
+                multipole_exact += exact;
+            }
+        }
+        return u;
+    } //!< Multipole expanded energy between two molecules; every `multipole_sample`th is compared with the exact sum
+
+    /*
+     * Energy of a subset, `index`, of group `g1` with all other groups
+     * using the cell list; equivalent to summing `g2g(g1, g2, index)` over
+     * all other groups. If `internal` is true, also pairs within `g1` where
+     * at least one particle is in `index` are included (as `g_internal`).
+     * An empty `index` means all particles in `g1`.
+     */
+    double g2all(const typename Tspace::Tgroup &g1, const std::vector<int> &index, bool internal) {
+        double u = 0;
+        int gi = &g1 - &spc.groups.front();
+        int offset = std::distance(spc.p.begin(), g1.begin());
+        std::vector<int> moved = index;
+        if (moved.empty()) {
+            moved.resize(g1.size());
+            std::iota(moved.begin(), moved.end(), 0);
+            if (molecules.at(g1.id).rigid)
+                internal = false; // as in `g_internal()`
+        }
+        for (int i : moved)
+            ismoved[offset + i] = 1;
+        for (int i : moved) {
+            int n = offset + i;
+            forEachPartner(n, [&](int m) {
+                if (isActive(m)) {
+                    if (groupOf[m] == gi) {
+                        if (internal and (not ismoved[m] or m > n))
+                            u += i2i(spc.p[n], spc.p[m]);
+                    } else if (not celllistCut(gi, groupOf[m]))
+                        u += i2i(spc.p[n], spc.p[m]);
+                }
+            });
+        }
+        for (int i : moved)
+            ismoved[offset + i] = 0;
+        return u;
+    }
+
+    /*
+     * Energy of all pairs using the cell list; equivalent to `g2g()` for all
+     * group pairs plus internal energies of either all (`internal=true`)
+     * or only atomic groups.
+     */
+    double celllistEnergy(bool internal) {
+        double u = 0;
+        celllist.forEachPair([&](int n, int m) {
+            if (isActive(n) and isActive(m)) {
+                int gi = groupOf[n], gj = groupOf[m];
+                if (gi == gj) {
+                    auto &g = spc.groups[gi];
+                    if ((internal or g.atomic) and not molecules.at(g.id).rigid)
+                        u += i2i(spc.p[n], spc.p[m]);
+                } else if (not celllistCut(gi, gj))
+                    u += i2i(spc.p[n], spc.p[m]);
+            }
+        });
+        return u;
+    }
+
   protected:
     typedef typename Tspace::Tpvec Tpvec;
     typedef typename Tspace::Tgroup Tgroup;
     double Rc2_g2g = pc::infty;
+    double rcut2 = pc::infty; // squared particle-particle cutoff (`rmax`)
 
     // control of when OpenMP should be used
     bool omp_enable = false;
@@ -386,6 +1420,41 @@ template <typename Tpairpot> class Nonbonded : public Energybase {
                 _a.push_back("i2all");
             j["openmp"] = _a;
         }
+        if (celllist_enable)
+            j["celllist"] = true;
+        if (arrays_enable)
+            j["arrays"] = true;
+        if (bounding_enable) {
+            j["bounding"] = true;
+            if (g2gcnt > 0)
+                j["g2g skipped"] = g2gskip / g2gcnt;
+        }
+        if (multipole_enable) {
+            auto &_j = j["multipole"];
+            _j = {{"cutoff", std::sqrt(multipole_cutoff2)},
+                  {"lB", multipole_lB},
+                  {"sample", multipole_sample},
+                  {"expansions", multipole_cnt}};
+            if (not multipole_error.empty())
+                _j["error"] = {{"samples", multipole_error.cnt},
+                               {"mean", multipole_error.avg()},
+                               {"rms", multipole_error.rms()},
+                               {"mean exact", multipole_exact.avg()},
+                               {"rms exact", multipole_exact.rms()}};
+        }
+        if (rcut2 < pc::infty)
+            j["rmax"] = std::sqrt(rcut2);
+        if (skin > 0) {
+            j["verlet"] = true;
+            j["skin"] = skin;
+            j["verlet rebuilds"] = verlet_rebuilds;
+            if (celllist_ready and not verlet.empty()) {
+                double n = 0;
+                for (auto &v : verlet)
+                    n += v.size();
+                j["verlet size"] = n / verlet.size();
+            }
+        }
         j["cutoff_g2g"] = json::object();
         auto &_j = j["cutoff_g2g"];
         for (auto &a : Faunus::molecules)
@@ -398,7 +1467,7 @@ template <typename Tpairpot> class Nonbonded : public Energybase {
         g2gcnt++;
         if (g1.atomic || g2.atomic)
             return false;
-        if (spc.geo.sqdist(g1.cm, g2.cm) < cutoff2(g1.id, g2.id))
+        if (spc.geo.sqdist(g1.cm, g2.cm) < cutoff2(g1.id, g2.id) and not boundingCut(g1, g2))
             return false;
         g2gskip++;
         return true;
@@ -406,9 +1475,142 @@ template <typename Tpairpot> class Nonbonded : public Energybase {
 
     template <typename T> inline double i2i(const T &a, const T &b) {
         assert(&a != &b && "a and b cannot be the same particle");
-        return pairpot(a, b, spc.geo.vdist(a.pos, b.pos));
+        Point r = spc.geo.vdist(a.pos, b.pos);
+        if (r.squaredNorm() < rcut2)
+            return pairpot(a, b, r);
+        return 0;
+    }
+
+    /*
+     * Energy of particle `a` with particles [first,last) in `Space::p`, equivalent to
+     * calling `i2i()` for each pair. Minimum image distances are calculated in blocks
+     * from the structure-of-arrays copy of the particles using a branch-free loop
+     * that can be vectorised; the pair potential is evaluated only within the cutoff.
+     */
+    template <typename T> double i2range(const T &a, size_t first, size_t last) {
+        constexpr int blocksize = 64;
+        alignas(64) double dx[blocksize], dy[blocksize], dz[blocksize], r2[blocksize];
+        Point len = spc.geo.getLength(), half;
+        for (int d = 0; d < 3; d++)
+            if (not pbc[d])
+                len[d] = 0; // disable minimum image
+        half = 0.5 * len;
+        double u = 0;
+        for (size_t begin = first; begin < last; begin += blocksize) {
+            int n = int(std::min(last - begin, size_t(blocksize)));
+            const double *x = spc.arrays.x.data() + begin, *y = spc.arrays.y.data() + begin,
+                         *z = spc.arrays.z.data() + begin;
+#pragma omp simd
+            for (int k = 0; k < n; k++) {
+                double _x = a.pos.x() - x[k], _y = a.pos.y() - y[k], _z = a.pos.z() - z[k];
+                _x -= len.x() * ((_x > half.x()) - (_x < -half.x()));
+                _y -= len.y() * ((_y > half.y()) - (_y < -half.y()));
+                _z -= len.z() * ((_z > half.z()) - (_z < -half.z()));
+                dx[k] = _x;
+                dy[k] = _y;
+                dz[k] = _z;
+                r2[k] = _x * _x + _y * _y + _z * _z;
+            }
+            u += i2block(a, begin, n, dx, dy, dz, r2, Potential::has_batch<Tpairpot>());
+        }
+        return u;
+    }
+
+    /*
+     * Energy change of a particle moved from `a0` to `a1` with particles [first,last) in
+     * `Space::p` which must be unaffected by the move. Both positions are evaluated in
+     * the same loop so that each partner is loaded only once.
+     */
+    template <typename T> double i2rangeDelta(const T &a1, const T &a0, size_t first, size_t last) {
+        double u = 0;
+        if (not arrays_enable) {
+            for (size_t k = first; k < last; k++)
+                u += i2i(a1, spc.p[k]) - i2i(a0, spc.p[k]);
+            return u;
+        }
+        constexpr int blocksize = 64;
+        alignas(64) double dx1[blocksize], dy1[blocksize], dz1[blocksize], r21[blocksize];
+        alignas(64) double dx0[blocksize], dy0[blocksize], dz0[blocksize], r20[blocksize];
+        Point len = spc.geo.getLength(), half;
+        for (int d = 0; d < 3; d++)
+            if (not pbc[d])
+                len[d] = 0; // disable minimum image
+        half = 0.5 * len;
+        for (size_t begin = first; begin < last; begin += blocksize) {
+            int n = int(std::min(last - begin, size_t(blocksize)));
+            const double *x = spc.arrays.x.data() + begin, *y = spc.arrays.y.data() + begin,
+                         *z = spc.arrays.z.data() + begin;
+#pragma omp simd
+            for (int k = 0; k < n; k++) {
+                double _x = a1.pos.x() - x[k], _y = a1.pos.y() - y[k], _z = a1.pos.z() - z[k];
+                _x -= len.x() * ((_x > half.x()) - (_x < -half.x()));
+                _y -= len.y() * ((_y > half.y()) - (_y < -half.y()));
+                _z -= len.z() * ((_z > half.z()) - (_z < -half.z()));
+                dx1[k] = _x;
+                dy1[k] = _y;
+                dz1[k] = _z;
+                r21[k] = _x * _x + _y * _y + _z * _z;
+                _x = a0.pos.x() - x[k], _y = a0.pos.y() - y[k], _z = a0.pos.z() - z[k];
+                _x -= len.x() * ((_x > half.x()) - (_x < -half.x()));
+                _y -= len.y() * ((_y > half.y()) - (_y < -half.y()));
+                _z -= len.z() * ((_z > half.z()) - (_z < -half.z()));
+                dx0[k] = _x;
+                dy0[k] = _y;
+                dz0[k] = _z;
+                r20[k] = _x * _x + _y * _y + _z * _z;
+            }
+            u += i2block(a1, begin, n, dx1, dy1, dz1, r21, Potential::has_batch<Tpairpot>()) -
+                 i2block(a0, begin, n, dx0, dy0, dz0, r20, Potential::has_batch<Tpairpot>());
+        }
+        return u;
     }
 
+    template <typename T>
+    inline double i2block(const T &a, size_t begin, int n, const double *dx, const double *dy, const double *dz,
+                          const double *r2, std::false_type) {
+        double u = 0;
+        for (int k = 0; k < n; k++)
+            if (r2[k] < rcut2)
+                u += pairpot(a, spc.p[begin + k], Point(dx[k], dy[k], dz[k]));
+        return u;
+    } //!< Block energy from pair potential calls
+
+    template <typename T>
+    inline double i2block(const T &a, size_t begin, int n, const double *, const double *, const double *,
+                          const double *r2, std::true_type) {
+        constexpr int blocksize = 64;
+        assert(n <= blocksize);
+        alignas(64) double _r2[blocksize], _charge[blocksize];
+        alignas(64) int _id[blocksize];
+        int m = 0;
+        for (int k = 0; k < n; k++) { // pack pairs within cutoff
+            _r2[m] = r2[k];
+            _charge[m] = spc.arrays.charge[begin + k];
+            _id[m] = spc.arrays.id[begin + k];
+            m += (r2[k] < rcut2);
+        }
+        return pairpot.batch(a, _r2, _charge, _id, m);
+    } //!< Block energy from the batch kernel of the pair potential
+
+    template <typename T> inline double i2group(const T &a, const Tgroup &g) {
+        size_t first = std::distance(spc.p.begin(), g.begin());
+        if (arrays_enable)
+            return i2range(a, first, first + g.size());
+        double u = 0;
+        for (auto &b : g)
+            u += i2i(a, b);
+        return u;
+    } //!< Energy of particle `a` with all active particles in group `g`
+
+    void update(const Change &change) {
+        if (arrays_enable)
+            spc.updateArrays(change);
+        if (celllist_enable)
+            celllistUpdate(change);
+        boundingUpdate(change);
+        multipoleUpdate(change);
+    } //!< Refresh particle arrays, cell list, bounding spheres, and multipole moments from a change
+
     /*
      * Internal energy in group, calculating all with all or, if `index`
      * is given, only a subset. Index specifies the internal index (starting
@@ -417,14 +1619,50 @@ template <typename Tpairpot> class Nonbonded : public Energybase {
     double g_internal(const Tgroup &g, const std::vector<int> &index = std::vector<int>()) {
         using namespace ranges;
         double u = 0;
-        if (index.empty() and not molecules.at(g.id).rigid) // assume that all atoms have changed
-            for (auto i = g.begin(); i != g.end(); ++i)
-                for (auto j = i; ++j != g.end();)
-                    u += i2i(*i, *j);
+        if (celllist_ready) { // find partners via cell or Verlet list
+            if (index.empty() and molecules.at(g.id).rigid)
+                return u;
+            int gi = &g - &spc.groups.front();
+            int offset = std::distance(spc.p.begin(), g.begin());
+            auto pairs = [&](int n) {
+                forEachPartner(n, [&](int m) {
+                    if (groupOf[m] == gi and isActive(m) and (not ismoved[m] or m > n))
+                        u += i2i(spc.p[n], spc.p[m]);
+                });
+            };
+            if (index.empty()) { // all pairs
+                for (int i = 0; i < int(g.size()); i++)
+                    ismoved[offset + i] = 1;
+                for (int i = 0; i < int(g.size()); i++)
+                    pairs(offset + i);
+                for (int i = 0; i < int(g.size()); i++)
+                    ismoved[offset + i] = 0;
+            } else { // moved<->static and moved<->moved
+                for (int i : index)
+                    ismoved[offset + i] = 1;
+                for (int i : index)
+                    pairs(offset + i);
+                for (int i : index)
+                    ismoved[offset + i] = 0;
+            }
+            return u;
+        }
+        if (index.empty() and not molecules.at(g.id).rigid) { // assume that all atoms have changed
+            if (arrays_enable) {
+                size_t first = std::distance(spc.p.begin(), g.begin()), last = first + g.size();
+                for (size_t n = first; n < last and not stop(u); n++)
+                    u += i2range(spc.p[n], n + 1, last);
+            } else
+                for (auto i = g.begin(); i != g.end() and not stop(u); ++i)
+                    for (auto j = i; ++j != g.end();)
+                        u += i2i(*i, *j);
+        }
         else { // only a subset has changed
             auto fixed = view::ints(0, int(g.size())) |
                          view::remove_if([&index](int i) { return std::binary_search(index.begin(), index.end(), i); });
             for (int i : index) { // moved<->static
+                if (stop(u))
+                    return u;
                 for (int j : fixed) {
                     u += i2i(*(g.begin() + i), *(g.begin() + j));
                 }
@@ -444,26 +1682,61 @@ template <typename Tpairpot> class Nonbonded : public Energybase {
      */
     double i2all(const typename Tspace::Tparticle &i) {
         double u = 0;
+        if (celllist_ready and not spc.p.empty() and &i >= &spc.p.front() and &i <= &spc.p.back()) { // cell list
+            int n = &i - &spc.p.front();
+            if (isActive(n)) {
+                forEachPartner(n, [&](int m) {
+                    if (isActive(m))
+                        if (groupOf[m] == groupOf[n] or not celllistCut(groupOf[n], groupOf[m]))
+                            u += i2i(i, spc.p[m]);
+                });
+                return u;
+            }
+        }
         auto it = spc.findGroupContaining(i); // iterator to group
         if (it != spc.groups.end()) {         // check if i belongs to group in space
 #pragma omp parallel for reduction(+ : u) if (omp_enable and omp_i2all)
             for (size_t ig = 0; ig < spc.groups.size(); ig++) {
                 auto &g = spc.groups[ig];
-                if (&g != &(*it))         // avoid self-interaction
-                    if (not cut(g, *it))  // check g2g cut-off
-                        for (auto &j : g) // loop over particles in other group
-                            u += i2i(i, j);
-            }
-            for (auto &j : *it) // i with all particles in own group
-                if (&j != &i)
-                    u += i2i(i, j);
+                if (stop(u)) // partial sum already rejects the move
+                    continue;
+                if (&g != &(*it))        // avoid self-interaction
+                    if (not cut(g, *it) and not boundingCut(i.pos, ig)) // check g2g and bounding cut-off
+                        u += i2group(i, g);
+            }
+            if (arrays_enable) { // i with all particles in own group, split around i
+                size_t n = &i - &spc.p.front(), first = std::distance(spc.p.begin(), it->begin());
+                u += i2range(i, first, n) + i2range(i, n + 1, first + it->size());
+            } else
+                for (auto &j : *it) // i with all particles in own group
+                    if (&j != &i)
+                        u += i2i(i, j);
         } else                         // particle does not belong to any group
             for (auto &g : spc.groups) // i with all other *active* particles
-                for (auto &j : g)      // (this will include only active particles)
-                    u += i2i(i, j);
+                u += i2group(i, g);    // (this will include only active particles)
         return u;
     }
 
+    /*
+     * Energy change of particles `index` (absolute index in `Space::p`) in the moved group
+     * with the static group `g`. The mass center cutoff is checked for both the new and old
+     * moved group, `g1` and `g0`.
+     */
+    double g2gDelta(const Tgroup &g1, const Tgroup &g0, const Tgroup &g, const Tspace &old,
+                    const std::vector<size_t> &index) {
+        bool cut1 = cut(g1, g), cut0 = cut(g0, g);
+        double du = 0;
+        size_t first = std::distance(spc.p.begin(), g.begin()), last = first + g.size();
+        for (auto n : index)
+            if (not cut1 and not cut0)
+                du += i2rangeDelta(spc.p[n], old.p[n], first, last);
+            else if (not cut1)
+                du += i2group(spc.p[n], g);
+            else if (not cut0)
+                du -= i2group(old.p[n], g);
+        return du;
+    }
+
     /*
      * Group-to-group energy. A subset of `g1` can be given with `index` which refers
      * to the internal index (starting at zero) of the first group, `g1
@@ -477,15 +1750,19 @@ template <typename Tpairpot> class Nonbonded : public Energybase {
         using namespace ranges;
         double u = 0;
         if (not cut(g1, g2)) {
-            if (index.empty() && jndex.empty()) // if index is empty, assume all in g1 have changed
+            if (index.empty() and jndex.empty() and multipoleFar(g1, g2))
+                return g2gMultipole(g1, g2); // far-field expansion
+            if (g1.atomic != g2.atomic and jndex.empty() and boundingIndex(g1) >= 0 and boundingIndex(g2) >= 0)
+                return g2gAtomic(g1, g2, index); // visit only atoms near the molecule
+            if (index.empty() && jndex.empty()) { // if index is empty, assume all in g1 have changed
 #pragma omp parallel for reduction(+ : u) schedule(dynamic) if (omp_enable and omp_p2p)
                 for (size_t i = 0; i < g1.size(); i++)
-                    for (size_t j = 0; j < g2.size(); j++)
-                        u += i2i(*(g1.begin() + i), *(g2.begin() + j));
-            else { // only a subset of g1
+                    if (not stop(u))
+                        u += i2group(*(g1.begin() + i), g2);
+            } else { // only a subset of g1
                 for (auto i : index)
-                    for (auto j = g2.begin(); j != g2.end(); ++j)
-                        u += i2i(*(g1.begin() + i), *j);
+                    if (not stop(u))
+                        u += i2group(*(g1.begin() + i), g2);
                 if (not jndex.empty()) {
                     auto fixed = view::ints(0, int(g1.size())) | view::remove_if([&index](int i) {
                                      return std::binary_search(index.begin(), index.end(), i);
@@ -506,6 +1783,8 @@ template <typename Tpairpot> class Nonbonded : public Energybase {
     Nonbonded(const json &j, Tspace &spc) : spc(spc) {
         name = "nonbonded";
         pairpot = j;
+        if (Potential::is_repulsive<Tpairpot>::value)
+            umin = 0;
 
         // controls for OpenMP
         auto it = j.find("openmp");
@@ -557,8 +1836,86 @@ template <typename Tpairpot> class Nonbonded : public Energybase {
                 }
             }
         }
+
+        // Verlet lists; implies a cell list for building the lists
+        if (j.value("verlet", false)) {
+            skin = j.value("skin", 1.0);
+            if (skin <= 0)
+                throw std::runtime_error("verlet skin must be positive");
+        }
+
+        // opt-in loop over the structure-of-arrays particle copy, `Space::arrays`
+        arrays_enable = j.value("arrays", false);
+        if (arrays_enable)
+            spc.arrays_enable = true;
+
+        // cell list for finding interaction partners
+        celllist_enable = j.value("celllist", false) or skin > 0;
+        bounding_enable = j.value("bounding", false);
+        if (celllist_enable or arrays_enable or bounding_enable) {
+            switch (spc.geo.type) {
+            case Geometry::CUBOID:
+                pbc = {{true, true, true}};
+                break;
+            case Geometry::SLIT:
+                pbc = {{true, true, false}};
+                break;
+            case Geometry::CYLINDER:
+                pbc = {{false, false, true}};
+                break;
+            case Geometry::SPHERE:
+                pbc = {{false, false, false}};
+                break;
+            default:
+                throw std::runtime_error(
+                    "celllist, bounding, and arrays require a cuboid, slit, cylinder, or sphere geometry");
+            }
+            if (j.count("rmax") == 1)
+                rcut2 = std::pow(j.at("rmax").get<double>(), 2);
+            else if (celllist_enable or bounding_enable)
+                throw std::runtime_error("celllist and bounding require a pair-potential cutoff, `rmax`");
+            if (celllist_enable)
+                celllistBuild();
+            if (bounding_enable)
+                boundingBuild();
+        }
+
+        // far-field multipole expansion between rigid molecules
+        it = j.find("multipole");
+        if (it != j.end()) {
+            if (celllist_enable)
+                throw std::runtime_error("multipole cannot be combined with celllist");
+            multipole_enable = true;
+            multipole_cutoff2 = std::pow(it->at("cutoff").get<double>(), 2);
+            multipole_lB = pc::lB(it->at("epsr").get<double>());
+            multipole_sample = it->value("sample", 0u);
+            Change change;
+            change.all = true;
+            multipoleUpdate(change);
+        }
     }
 
+    void init() override {
+        if (arrays_enable) {
+            spc.arrays_enable = true;
+            spc.arrays.assign(spc.p);
+        }
+        if (celllist_enable)
+            celllistBuild();
+        if (bounding_enable)
+            boundingBuild();
+        Change change;
+        change.all = true;
+        multipoleUpdate(change);
+    }
+
+    void sync(Energybase *, Change &change) override {
+        if (celllist_enable)
+            celllistUpdate(change);
+        boundingUpdate(change);
+        multipoleUpdate(change);
+    } //!< Space is assumed to be synced before this call
+
     void force(std::vector<Point> &forces) override {
         auto &p = spc.p; // alias to particle vector (reference)
         assert(forces.size() == p.size() && "the forces size must match the particle size");
@@ -574,10 +1931,16 @@ template <typename Tpairpot> class Nonbonded : public Energybase {
     double energy(Change &change) override {
         using namespace ranges;
         double u = 0;
+        early = change.umax < pc::infty;
+        ustop = Potential::is_repulsive<Tpairpot>::value ? change.umax : pc::infty; // else stop only on overlap
 
         if (change) {
 
+            update(change);
+
             if (change.dV) {
+                if (celllist_ready)
+                    return celllistEnergy(false);
 #pragma omp parallel for reduction(+ : u) schedule(dynamic) if (omp_enable and omp_g2g)
                 for (auto i = spc.groups.begin(); i < spc.groups.end(); ++i) {
                     for (auto j = i; ++j != spc.groups.end();)
@@ -590,6 +1953,8 @@ template <typename Tpairpot> class Nonbonded : public Energybase {
 
             // did everything change?
             if (change.all) {
+                if (celllist_ready)
+                    return celllistEnergy(true);
 #pragma omp parallel for reduction(+ : u) schedule(dynamic) if (omp_enable and omp_g2g)
                 for (auto i = spc.groups.begin(); i < spc.groups.end(); ++i) {
                     for (auto j = i; ++j != spc.groups.end();)
@@ -611,14 +1976,16 @@ template <typename Tpairpot> class Nonbonded : public Energybase {
 
                 // more atoms moved
                 auto &g1 = spc.groups.at(d.index);
+                if (celllist_ready)
+                    return g2all(g1, d.atoms, d.internal);
                 // for (auto &g2 : spc.groups)
 #pragma omp parallel for reduction(+ : u) schedule(dynamic) if (omp_enable and omp_g2g)
                 for (size_t i = 0; i < spc.groups.size(); i++) {
                     auto &g2 = spc.groups[i];
-                    if (&g1 != &g2)
+                    if (&g1 != &g2 and not stop(u))
                         u += g2g(g1, g2, d.atoms);
                 }
-                if (d.internal)
+                if (d.internal and not stop(u))
                     u += g_internal(g1, d.atoms);
                 return u;
             }
@@ -698,14 +2065,567 @@ template <typename Tpairpot> class Nonbonded : public Energybase {
         return u;
     }
 
+    bool hasDelta(const Change &change) const override {
+        return not(change.all or change.dV or change.dN or celllist_ready or multipole_enable or
+                   change.groups.empty());
+    }
+
+    /*
+     * Same energy change as `energy()` on the trial minus the old state, but each static
+     * partner is loaded once and used with both the new and old positions of the moved particles.
+     */
+    double delta(Change &change, const Tspace &old, const Tspace &trial) override {
+        using namespace ranges;
+        assert(&trial == &spc);
+        assert(hasDelta(change));
+        early = false;
+        update(change);
+        double du = 0;
+
+        if (change.groups.size() == 1) {
+            auto &d = change.groups[0];
+            auto &g1 = spc.groups.at(d.index); // moved group, new
+            auto &g0 = old.groups.at(d.index); // moved group, old
+            size_t offset = std::distance(spc.p.begin(), g1.begin());
+            std::vector<size_t> index; // moved particles
+            if (d.atoms.empty())
+                for (size_t n = offset; n < offset + g1.size(); n++)
+                    index.push_back(n);
+            else
+                for (int i : d.atoms)
+                    index.push_back(offset + i);
+
+#pragma omp parallel for reduction(+ : du) schedule(dynamic) if (omp_enable and omp_g2g)
+            for (size_t i = 0; i < spc.groups.size(); i++)
+                if (int(i) != d.index)
+                    du += g2gDelta(g1, g0, spc.groups[i], old, index);
+
+            if (d.atoms.size() == 1) { // as `i2all()`, all other particles in own group
+                size_t n = index[0];
+                return du + i2rangeDelta(spc.p[n], old.p[n], offset, n) +
+                       i2rangeDelta(spc.p[n], old.p[n], n + 1, offset + g1.size());
+            }
+            if (d.internal) { // as `g_internal()`
+                if (d.atoms.empty() and molecules.at(g1.id).rigid)
+                    return du;
+                if (not d.atoms.empty()) { // moved<->static, in ranges between moved particles
+                    size_t begin = offset;
+                    for (auto n : index) {
+                        for (auto m : index)
+                            du += i2rangeDelta(spc.p[m], old.p[m], begin, n);
+                        begin = n + 1;
+                    }
+                    for (auto m : index)
+                        du += i2rangeDelta(spc.p[m], old.p[m], begin, offset + g1.size());
+                }
+                for (auto i = index.begin(); i != index.end(); ++i) // moved<->moved
+                    for (auto j = i; ++j != index.end();)
+                        du += i2i(spc.p[*i], spc.p[*j]) - i2i(old.p[*i], old.p[*j]);
+            }
+            return du;
+        }
+
+        auto moved = change.touchedGroupIndex(); // index of moved groups
+        auto fixed = view::ints(0, int(spc.groups.size())) | view::remove_if([&moved](int i) {
+                         return std::binary_search(moved.begin(), moved.end(), i);
+                     }); // index of static groups
+
+        // moved<->moved
+        if (change.moved2moved)
+            for (auto i = moved.begin(); i != moved.end(); ++i)
+                for (auto j = i; ++j != moved.end();) {
+                    du += g2g(spc.groups[*i], spc.groups[*j]);
+                    if (not cut(old.groups[*i], old.groups[*j]))
+                        for (auto &a : old.groups[*i])
+                            for (auto &b : old.groups[*j])
+                                du -= i2i(a, b);
+                }
+
+        // moved<->static
+        for (auto i : moved) {
+            auto &g1 = spc.groups[i];
+            std::vector<size_t> index(g1.size());
+            std::iota(index.begin(), index.end(), std::distance(spc.p.begin(), g1.begin()));
+            for (auto j : fixed)
+                du += g2gDelta(g1, old.groups[i], spc.groups[j], old, index);
+        }
+        return du;
+    }
+
 }; //!< Nonbonded, pair-wise additive energy term
 
+#ifdef DOCTEST_LIBRARY_INCLUDED
+TEST_CASE("[Faunus] Nonbonded - celllist") {
+    using doctest::Approx;
+    auto atoms_backup = atoms;
+    auto molecules_backup = molecules;
+    atoms = R"([{"A": {"sigma": 2.0}}])"_json.get<decltype(atoms)>();
+    molecules = R"([{"salt": {"atoms": ["A"], "atomic": true}}])"_json.get<decltype(molecules)>();
+
+    for (auto geometry : {R"({"type": "cuboid", "length": [20, 24, 28]})"_json,
+                          R"({"type": "slit", "length": [20, 24, 28]})"_json,
+                          R"({"type": "cylinder", "radius": 12, "length": 28})"_json,
+                          R"({"type": "sphere", "radius": 14})"_json}) {
+        Tspace spc;
+        spc.geo = geometry;
+        Tspace::Tpvec p(500);
+        for (size_t i = 0; i < p.size(); i++) {
+            p[i].id = 0;
+            p[i].charge = (i % 2 == 0) ? 1.0 : -1.0;
+            spc.geo.randompos(p[i].pos, Faunus::random);
+        }
+        spc.push_back(0, p);
+        spc.groups.front().resize(400); // last 100 are inactive
+
+        json j = R"({"coulomb": {"type": "plain", "epsr": 1, "cutoff": 6}, "rmax": 6})"_json;
+        Nonbonded<Potential::CoulombGalore> brute(j, spc);
+        j["arrays"] = true;
+        Nonbonded<Potential::CoulombGalore> arrays(j, spc);
+        j.erase("arrays");
+        j["celllist"] = true;
+        Nonbonded<Potential::CoulombGalore> cells(j, spc);
+        j["verlet"] = true;
+        j["skin"] = 1.5;
+        Nonbonded<Potential::CoulombGalore> verlet(j, spc);
+
+        Change change;
+        change.all = true;
+        double u = brute.energy(change);
+        CHECK(u == Approx(cells.energy(change)));
+        CHECK(u == Approx(verlet.energy(change)));
+        CHECK(u == Approx(arrays.energy(change)));
+
+        // single particle displacements, including across the periodic boundary
+        change.clear();
+        change.groups.resize(1);
+        change.groups[0].index = 0;
+        for (int i : {0, 1, 17, 399}) {
+            change.groups[0].atoms = {i};
+            Point &pos = spc.p[i].pos;
+            pos += Point(9.5, -11.5, 13.5);
+            spc.geo.boundary(pos);
+            u = brute.energy(change);
+            CHECK(u == Approx(cells.energy(change)));
+            CHECK(u == Approx(verlet.energy(change)));
+            CHECK(u == Approx(arrays.energy(change)));
+        }
+
+        // many small displacements where Verlet lists are only partially rebuilt
+        for (int n = 0; n < 200; n++) {
+            int i = n % 5;
+            change.groups[0].atoms = {i};
+            Point &pos = spc.p[i].pos;
+            Point old = pos;
+            pos += 0.3 * ranunit(Faunus::random);
+            spc.geo.boundary(pos);
+            if (spc.geo.collision(pos))
+                pos = old;
+            u = brute.energy(change);
+            CHECK(u == Approx(cells.energy(change)));
+            CHECK(u == Approx(verlet.energy(change)));
+            CHECK(u == Approx(arrays.energy(change)));
+        }
+
+        // several particles moved
+        change.groups[0].internal = true;
+        change.groups[0].atoms = {2, 3, 200};
+        for (int i : change.groups[0].atoms)
+            spc.p[i].pos = -spc.p[i].pos;
+        u = brute.energy(change);
+        CHECK(u == Approx(cells.energy(change)));
+        CHECK(u == Approx(verlet.energy(change)));
+        CHECK(u == Approx(arrays.energy(change)));
+
+        // activate particles; the cell list is updated from the change object
+        spc.groups.front().resize(450);
+        change.groups[0].all = true;
+        change.groups[0].atoms.clear();
+        u = brute.energy(change);
+        CHECK(u == Approx(cells.energy(change)));
+        CHECK(u == Approx(verlet.energy(change)));
+        CHECK(u == Approx(arrays.energy(change)));
+
+        // deactivate particles
+        spc.groups.front().resize(300);
+        cells.sync(&brute, change);
+        verlet.sync(&brute, change);
+        CHECK(brute.energy(change) == Approx(cells.energy(change)));
+        CHECK(brute.energy(change) == Approx(verlet.energy(change)));
+        CHECK(brute.energy(change) == Approx(arrays.energy(change)));
+        CHECK(brute.energy(change) != Approx(u));
+
+        // atomic deletion as in speciation: a particle is swapped with the last active
+        // particle and only the deactivated slot is listed in the change
+        auto &g = spc.groups.front();
+        std::iter_swap(g.begin() + 5, g.end() - 1);
+        change.clear();
+        change.dN = true;
+        change.groups.resize(1);
+        change.groups[0].index = 0;
+        change.groups[0].internal = true;
+        change.groups[0].dNatomic = true;
+        change.groups[0].atoms = {int(g.size()) - 1};
+        g.deactivate(g.end() - 1, g.end());
+        u = brute.energy(change);
+        CHECK(u == Approx(cells.energy(change)));
+        CHECK(u == Approx(verlet.energy(change)));
+        CHECK(u == Approx(arrays.energy(change)));
+
+        // interactions with the swapped particle, which is not listed itself
+        change.clear();
+        change.groups.resize(1);
+        change.groups[0].index = 0;
+        change.groups[0].internal = true;
+        for (int i = 0; i < int(g.size()); i++)
+            if (i != 5)
+                change.groups[0].atoms.push_back(i);
+        u = brute.energy(change);
+        CHECK(u == Approx(cells.energy(change)));
+        CHECK(u == Approx(verlet.energy(change)));
+        CHECK(u == Approx(arrays.energy(change)));
+    }
+
+    atoms = atoms_backup;
+    molecules = molecules_backup;
+}
+
+TEST_CASE("[Faunus] Nonbonded - early rejection") {
+    using doctest::Approx;
+    auto atoms_backup = atoms;
+    auto molecules_backup = molecules;
+    atoms = R"([{"A": {"sigma": 2.0, "eps": 1.0}}])"_json.get<decltype(atoms)>();
+    molecules = R"([{"salt": {"atoms": ["A"], "atomic": true}}])"_json.get<decltype(molecules)>();
+
+    CHECK(Potential::is_repulsive<Potential::WeeksChandlerAndersen<Particle>>::value);
+    CHECK(Potential::is_repulsive<Potential::HardSphere<Particle>>::value);
+    CHECK(not Potential::is_repulsive<Potential::CoulombGalore>::value);
+
+    Tspace spc;
+    spc.geo = R"({"type": "cuboid", "length": 30})"_json;
+    for (int n = 0; n < 10; n++) {
+        Tspace::Tpvec p(10);
+        for (auto &i : p) {
+            i.id = 0;
+            i.charge = 1;
+            spc.geo.randompos(i.pos, Faunus::random);
+        }
+        spc.push_back(0, p);
+    }
+    auto &a = *spc.groups[0].begin(); // moved onto particle in the next group
+    a.pos = spc.groups[1].begin()->pos + Point(1, 0, 0);
+    spc.geo.boundary(a.pos);
+
+    Change change;
+    Change::data d;
+    d.index = 0;
+    d.atoms = {0};
+    change.groups.push_back(d);
+
+    Nonbonded<Potential::WeeksChandlerAndersen<Particle>> wca(R"({"wca": {"mixing": "LB"}})"_json, spc);
+    CHECK(wca.umin == 0);
+    double u = wca.energy(change);
+    CHECK(u > 1);
+    change.umax = 1; // stops once reached
+    CHECK(wca.energy(change) >= 1);
+    CHECK(wca.energy(change) <= u);
+
+    // summation of potentials with negative energies stops only for infinite energies
+    change.umax = pc::infty;
+    Nonbonded<Potential::CoulombGalore> coulomb(R"({"coulomb": {"type": "plain", "epsr": 1}})"_json, spc);
+    CHECK(coulomb.umin == -pc::infty);
+    u = coulomb.energy(change);
+    change.umax = u - 1;
+    CHECK(coulomb.energy(change) == Approx(u));
+
+    Nonbonded<Potential::HardSphere<Particle>> hs(json::object(), spc);
+    CHECK(hs.energy(change) == pc::infty);
+
+    atoms = atoms_backup;
+    molecules = molecules_backup;
+}
+
+TEST_CASE("[Faunus] Nonbonded - bounding spheres") {
+    using doctest::Approx;
+    auto atoms_backup = atoms;
+    auto molecules_backup = molecules;
+    atoms = R"([{"A": {"sigma": 2.0}}])"_json.get<decltype(atoms)>();
+    molecules = R"([{"trimer": {"structure": [{"A": [0, 0, 0]}, {"A": [2, 0, 0]}, {"A": [4, 0, 0]}]}},
+                    {"salt": {"atoms": ["A"], "atomic": true}}])"_json.get<decltype(molecules)>();
+
+    Tspace spc;
+    spc.geo = R"({"type": "cuboid", "length": 40})"_json;
+    for (int n = 0; n < 40; n++) {
+        Tspace::Tpvec p(3);
+        Point cm;
+        spc.geo.randompos(cm, Faunus::random);
+        for (int k = 0; k < 3; k++) {
+            p[k].id = 0;
+            p[k].charge = (k == 1) ? -1 : 1;
+            p[k].pos = cm + Point(2 * k - 2, 0, 0);
+            spc.geo.boundary(p[k].pos);
+        }
+        spc.push_back(0, p);
+    }
+    Tspace::Tpvec salt(400);
+    for (size_t k = 0; k < salt.size(); k++) {
+        salt[k].id = 0;
+        salt[k].charge = (k % 2 == 0) ? 1 : -1;
+        spc.geo.randompos(salt[k].pos, Faunus::random);
+    }
+    spc.push_back(1, salt);
+    spc.groups.back().resize(350); // last 50 ions are inactive
+    int isalt = spc.groups.size() - 1;
+
+    json j = R"({"coulomb": {"type": "plain", "epsr": 1, "cutoff": 8}, "rmax": 8})"_json;
+    Nonbonded<Potential::CoulombGalore> brute(j, spc);
+    j["bounding"] = true;
+    Nonbonded<Potential::CoulombGalore> bounding(j, spc);
+    j.erase("rmax");
+    CHECK_THROWS(Nonbonded<Potential::CoulombGalore>(j, spc));
+
+    Change change;
+    change.all = true;
+    CHECK(brute.energy(change) == Approx(bounding.energy(change)));
+    CHECK(json(bounding)["nonbonded"]["g2g skipped"] > 0.5); // most molecule pairs are far apart
+
+    // translate molecules, also across the periodic boundary
+    change.clear();
+    change.groups.resize(1);
+    for (int k : {0, 7, 39}) {
+        auto &g = spc.groups[k];
+        g.translate(Point(13.5, -17.5, 9.5), spc.geo.getBoundaryFunc());
+        change.groups[0].index = k;
+        change.groups[0].all = true;
+        CHECK(brute.energy(change) == Approx(bounding.energy(change)));
+    }
+
+    // move a single atom in a molecule which changes its bounding radius
+    auto &g = spc.groups[3];
+    g.begin()->pos += Point(0, 1.5, 0);
+    spc.geo.boundary(g.begin()->pos);
+    g.cm = Geometry::massCenter(g.begin(), g.end(), spc.geo.getBoundaryFunc(), -g.cm);
+    change.groups[0].index = 3;
+    change.groups[0].all = false;
+    change.groups[0].internal = true;
+    change.groups[0].atoms = {0};
+    CHECK(brute.energy(change) == Approx(bounding.energy(change)));
+
+    // single ions, and then several at once
+    change.groups[0].index = isalt;
+    change.groups[0].internal = false;
+    for (int i : {0, 1, 349}) {
+        auto &a = *(spc.groups[isalt].begin() + i);
+        change.groups[0].atoms = {i};
+        a.pos += Point(9.5, -11.5, 13.5);
+        spc.geo.boundary(a.pos);
+        CHECK(brute.energy(change) == Approx(bounding.energy(change)));
+    }
+    change.groups[0].internal = true;
+    change.groups[0].atoms = {2, 3, 200};
+    for (int i : change.groups[0].atoms)
+        (spc.groups[isalt].begin() + i)->pos *= -1;
+    CHECK(brute.energy(change) == Approx(bounding.energy(change)));
+
+    // activate and deactivate ions; the atom blocks follow the change object
+    change.groups[0].atoms.clear();
+    change.groups[0].dNatomic = true;
+    for (int n : {380, 300}) {
+        spc.groups[isalt].resize(n);
+        change.groups[0].atoms = {n - 1};
+        bounding.sync(&brute, change);
+        Change all;
+        all.all = true;
+        CHECK(brute.energy(change) == Approx(bounding.energy(change)));
+        CHECK(brute.energy(all) == Approx(bounding.energy(all)));
+    }
+
+    atoms = atoms_backup;
+    molecules = molecules_backup;
+}
+
+TEST_CASE("[Faunus] Nonbonded - multipole") {
+    using doctest::Approx;
+    auto atoms_backup = atoms;
+    auto molecules_backup = molecules;
+    atoms = R"([{"A": {"sigma": 2.0}}])"_json.get<decltype(atoms)>();
+    molecules = R"([{"rigid": {"rigid": true, "structure": [
+                        {"A": [0, 0, 0]}, {"A": [2, 0, 0]}, {"A": [0, 3, 0]}, {"A": [1, 1, 2]}]}}])"_json
+                    .get<decltype(molecules)>();
+
+    Tspace spc;
+    spc.geo = R"({"type": "cuboid", "length": 300})"_json;
+    for (int n = 0; n < 2; n++) {
+        Tspace::Tpvec p(4);
+        std::vector<double> charges = {1.0, 1.0, -1.0, 0.5}; // charged and dipolar
+        for (int k = 0; k < 4; k++) {
+            p[k].id = 0;
+            p[k].charge = charges[k];
+        }
+        p[0].pos = {0, 0, 0};
+        p[1].pos = {2, 0, 0};
+        p[2].pos = {0, 3, 0};
+        p[3].pos = {1, 1, 2};
+        spc.push_back(0, p);
+    }
+
+    json j = R"({"coulomb": {"type": "plain", "epsr": 80}})"_json;
+    Nonbonded<Potential::CoulombGalore> exact(j, spc);
+    j["multipole"] = R"({"cutoff": 30, "epsr": 80, "sample": 1})"_json;
+    Nonbonded<Potential::CoulombGalore> expanded(j, spc);
+
+    Change change;
+    change.groups.resize(1);
+    change.groups[0].index = 1;
+    change.groups[0].all = true;
+    CHECK(not expanded.hasDelta(change));
+
+    // exact within the cutoff; the error decays with distance beyond it
+    auto &g = spc.groups[1];
+    double error = pc::infty;
+    for (double r : {10.0, 40.0, 80.0}) {
+        g.translate(Point(r, 0, 0) - g.cm, spc.geo.getBoundaryFunc());
+        double u = exact.energy(change), du = std::fabs(expanded.energy(change) - u);
+        if (r < 30)
+            CHECK(du == Approx(0));
+        else {
+            CHECK(du < 1e-3 * std::fabs(u));
+            CHECK(du < error);
+        }
+        error = du;
+    }
+
+    // moments follow rotations of the group
+    g.rotate(Eigen::Quaterniond(Eigen::AngleAxisd(1.2, Point(1, 2, 3).normalized())), spc.geo.getBoundaryFunc());
+    g.translate(Point(0, -35, 0), spc.geo.getBoundaryFunc());
+    double u = exact.energy(change);
+    CHECK(expanded.energy(change) == Approx(u).epsilon(1e-3));
+
+    // error report against the exact sum
+    json out = json(expanded)["nonbonded"]["multipole"];
+    CHECK(out["expansions"] == 3);
+    CHECK(out["error"]["samples"] == 3);
+    CHECK(std::fabs(out["error"]["mean"].get<double>()) < 1e-3 * std::fabs(u));
+
+    j["multipole"].erase("epsr");
+    CHECK_THROWS(Nonbonded<Potential::CoulombGalore>(j, spc));
+
+    atoms = atoms_backup;
+    molecules = molecules_backup;
+}
+#endif
+
 template <typename Tpairpot> class NonbondedCached : public Nonbonded<Tpairpot> {
   private:
     typedef Nonbonded<Tpairpot> base;
     typedef typename Tspace::Tgroup Tgroup;
+    typedef std::vector<std::pair<int, float>> Trow; // (group index, energy) sorted by group index
     Eigen::MatrixXf cache;
+    std::vector<Trow> rows; // sparse alternative to `cache`; non-zero energies stored in both rows
+    bool sparse = false;    // store only non-zero energies in `rows`?
+    bool internal = false;  // include (uncached) internal energies of groups?
     Tspace &spc;
+
+    struct Partial {
+        int i, j;  // group pair, i<j
+        double u;  // energy of changed particles only
+        bool cut;  // true if skipped due to mass center cutoff
+    };
+    std::vector<Partial> partials; // group pairs of the last partial change
+    bool partial = false;          // true if `energy()` evaluated a partial change since the last `sync()`
+
+    bool isPartial(const Change &change) const {
+        if (change.all or change.dV)
+            return false;
+        if (change.dN)
+            return true;
+        if (change.groups.size() != 1)
+            return false;
+        auto &d = change.groups[0];
+        return not d.all and not d.atoms.empty() and d.atoms.size() < spc.groups.at(d.index).size();
+    } //!< True if `energy()` treats `change` with the partial scheme, leaving the cache untouched
+
+    static Trow::iterator find(Trow &row, int j) {
+        return std::lower_bound(row.begin(), row.end(), j,
+                                [](const std::pair<int, float> &a, int j) { return a.first < j; });
+    }
+
+    static bool set(Trow &row, int j, float u) {
+        auto it = find(row, j);
+        if (it != row.end() and it->first == j) {
+            if (u == 0)
+                row.erase(it);
+            else
+                it->second = u;
+        } else if (u != 0)
+            row.insert(it, {j, u});
+        else
+            return false;
+        return true;
+    } //!< Set, insert, or erase (if zero) entry; false if nothing was done
+
+    float get(int i, int j) {
+        if (not sparse)
+            return cache(i, j);
+        auto &row = rows[i];
+        auto it = find(row, j);
+        return (it != row.end() and it->first == j) ? it->second : 0;
+    }
+
+    void set(int i, int j, float u) {
+        if (not sparse)
+            cache(i, j) = u;
+        else if (base::omp_enable) {
+#pragma omp critical(nonbonded_cached)
+            if (set(rows[i], j, u))
+                set(rows[j], i, u);
+        } else if (set(rows[i], j, u)) // rows are symmetric so if nothing was
+            set(rows[j], i, u);         // done to `i`, nothing need be done to `j`
+    }
+
+    /*
+     * Sum of cached energies in row `i`, skipping groups in the sorted vector
+     * `skip`. Used for the old state where the cache is up-to-date and, if sparse,
+     * only non-zero entries need be visited.
+     */
+    double rowsum(int i, const std::vector<int> &skip = std::vector<int>()) const {
+        double u = 0;
+        for (auto &e : rows[i])
+            if (not std::binary_search(skip.begin(), skip.end(), e.first))
+                u += e.second;
+        return u;
+    }
+
+    double full(const Tgroup &g1, const Tgroup &g2) {
+        double u = 0;
+        if (not base::cut(g1, g2)) {
+            for (auto &i : g1)
+                for (auto &j : g2)
+                    u += base::i2i(i, j);
+        }
+        return u;
+    } //!< Energy between all active particles in two groups
+
+    /*
+     * Energy of group pair `i`,`j` involving only the changed particles, `index`
+     * in group `i` and `jndex` in group `j` (both sorted). The cache is not touched;
+     * it is updated from the difference between the old and new states in `sync()`.
+     */
+    Partial partialg2g(int i, int j, const std::vector<int> &index, const std::vector<int> &jndex) {
+        auto &g1 = spc.groups[i];
+        auto &g2 = spc.groups[j];
+        Partial p = {std::min(i, j), std::max(i, j), 0, base::cut(g1, g2)};
+        if (not p.cut) {
+            for (int k : index) // changed1 <-> all2
+                p.u += base::i2group(*(g1.begin() + k), g2);
+            if (not jndex.empty())
+                for (int k = 0; k < int(g1.size()); k++) // changed2 <-> static1
+                    if (not std::binary_search(index.begin(), index.end(), k))
+                        for (int l : jndex)
+                            p.u += base::i2i(*(g2.begin() + l), *(g1.begin() + k));
+        }
+        return p;
+    }
+
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-parameter"
     double g2g(const Tgroup &g1, const Tgroup &g2, const std::vector<int> &index = std::vector<int>(),
@@ -716,39 +2636,39 @@ template <typename Tpairpot> class NonbondedCached : public Nonbonded<Tpairpot>
         if (j < i)
             std::swap(i, j);
         if (base::key == Energybase::NEW) { // if this is from the trial system,
-            double u = 0;
-            if (not base::cut(g1, g2)) {
-                for (auto &i : g1)
-                    for (auto &j : g2)
-                        u += base::i2i(i, j);
-            }
-            cache(i, j) = u;
+            double u = full(g1, g2);
+            set(i, j, u);
+            return float(u);
         }
-        return cache(i, j); // return (cached) value
-    }
+        return get(i, j); // return (cached) value
+    } //!< Energy of *all* particles in the two groups; `index` and `jndex` are ignored
 
   public:
     NonbondedCached(const json &j, Tspace &spc) : base(j, spc), spc(spc) {
         base::name += "EM";
+        sparse = j.value("sparse", false);
+        internal = j.value("internal", false);
         init();
     }
 
     void init() override {
-        cache.resize(spc.groups.size(), spc.groups.size());
-        cache.setZero();
+        base::init();
+        partial = false;
+        partials.clear();
+        if (sparse) {
+            rows.clear();
+            rows.resize(spc.groups.size());
+        } else {
+            cache.resize(spc.groups.size(), spc.groups.size());
+            cache.setZero();
+        }
         for (auto i = base::spc.groups.begin(); i < base::spc.groups.end(); ++i) {
             for (auto j = i; ++j != base::spc.groups.end();) {
                 int k = &(*i) - &base::spc.groups.front();
                 int l = &(*j) - &base::spc.groups.front();
                 if (l < k)
                     std::swap(k, l);
-                double u = 0;
-                if (!base::cut(*i, *j)) {
-                    for (auto &k : *i)
-                        for (auto &l : *j)
-                            u += base::i2i(k, l);
-                }
-                cache(k, l) = u;
+                set(k, l, full(*i, *j));
             }
         }
     } //!< Cache pair interactions in matrix
@@ -756,29 +2676,60 @@ template <typename Tpairpot> class NonbondedCached : public Nonbonded<Tpairpot>
     double energy(Change &change) override {
         using namespace ranges;
         double u = 0;
+        partial = false;
+        partials.clear();
 
         if (change) {
+            base::update(change);
 
             if (change.all || change.dV) {
+                if (sparse and base::key == Energybase::OLD) {
+                    for (size_t i = 0; i < rows.size(); i++)
+                        for (auto &e : rows[i])
+                            if (e.first > int(i))
+                                u += e.second;
+                } else {
 #pragma omp parallel for reduction(+ : u) schedule(dynamic) if (this->omp_enable)
-                for (auto i = base::spc.groups.begin(); i < base::spc.groups.end(); ++i) {
-                    for (auto j = i; ++j != base::spc.groups.end();)
-                        u += g2g(*i, *j);
+                    for (auto i = base::spc.groups.begin(); i < base::spc.groups.end(); ++i) {
+                        for (auto j = i; ++j != base::spc.groups.end();)
+                            u += g2g(*i, *j);
+                    }
                 }
+                if (internal) // internal energies are not cached
+                    for (auto &g : spc.groups)
+                        if (change.all or g.atomic)
+                            u += base::g_internal(g);
                 return u;
             }
 
             // if exactly ONE molecule is changed
-            if (change.groups.size() == 1) {
+            if (change.groups.size() == 1 && not change.dN) {
                 auto &d = change.groups[0];
                 auto &g1 = base::spc.groups.at(d.index);
 
+                // only a subset of particles changed: as in `Nonbonded`, the energy
+                // involves changed particles only and the cache is updated in `sync()`
+                if (not d.all and not d.atoms.empty() and d.atoms.size() < g1.size()) {
+                    partial = true;
+                    partials.resize(spc.groups.size() - 1);
 #pragma omp parallel for reduction(+ : u) schedule(dynamic) if (this->omp_enable and this->omp_g2g)
-                for (size_t i = 0; i < spc.groups.size(); i++) {
-                    auto &g2 = spc.groups[i];
-                    if (&g1 != &g2)
-                        u += g2g(g1, g2, d.atoms);
+                    for (size_t i = 0; i < partials.size(); i++) {
+                        int j = (int(i) < d.index) ? int(i) : int(i) + 1; // skip group itself
+                        partials[i] = partialg2g(d.index, j, d.atoms, {});
+                        u += partials[i].u;
+                    }
+                } else if (sparse and base::key == Energybase::OLD)
+                    u += rowsum(d.index);
+                else {
+#pragma omp parallel for reduction(+ : u) schedule(dynamic) if (this->omp_enable and this->omp_g2g)
+                    for (size_t i = 0; i < spc.groups.size(); i++) {
+                        auto &g2 = spc.groups[i];
+                        if (&g1 != &g2)
+                            u += g2g(g1, g2, d.atoms);
+                    }
                 }
+                if (internal and d.internal)
+                    u += base::g_internal(g1, d.atoms);
                 return u;
             }
 
@@ -787,13 +2738,46 @@ template <typename Tpairpot> class NonbondedCached : public Nonbonded<Tpairpot>
                              return std::binary_search(moved.begin(), moved.end(), i);
                          }); // index of static groups
 
+            // particles inserted or deleted; same partial scheme as for a single group
+            if (change.dN) {
+                partial = true;
+                for (auto cg1 = change.groups.begin(); cg1 < change.groups.end(); ++cg1) {
+                    std::vector<int> ifiltered, jfiltered; // active atoms
+                    auto &g1 = spc.groups.at(cg1->index);
+                    for (auto i : cg1->atoms)
+                        if (i < g1.size())
+                            ifiltered.push_back(i);
+                    for (auto j : fixed) {
+                        partials.push_back(partialg2g(cg1->index, j, ifiltered, jfiltered));
+                        u += partials.back().u;
+                    }
+                    for (auto cg2 = cg1; ++cg2 != change.groups.end();) {
+                        jfiltered.clear();
+                        for (auto i : cg2->atoms)
+                            if (i < spc.groups.at(cg2->index).size())
+                                jfiltered.push_back(i);
+                        partials.push_back(partialg2g(cg1->index, cg2->index, ifiltered, jfiltered));
+                        u += partials.back().u;
+                    }
+                    if (internal and not ifiltered.empty() and not molecules.at(g1.id).rigid)
+                        u += cg1->all ? base::g_internal(g1) : base::g_internal(g1, ifiltered);
+                }
+                return u;
+            }
+
             // moved<->moved
             if (change.moved2moved)
                 for (auto i = moved.begin(); i != moved.end(); ++i)
                     for (auto j = i; ++j != moved.end();)
                         u += g2g(base::spc.groups[*i], base::spc.groups[*j]);
             // moved<->static
-            if (this->omp_enable and this->omp_g2g) {
+            if (sparse and base::key == Energybase::OLD) {
+                std::vector<int> skip;
+                for (auto i : moved)
+                    skip.push_back(i);
+                for (auto i : skip)
+                    u += rowsum(i, skip);
+            } else if (this->omp_enable and this->omp_g2g) {
                 std::vector<std::pair<int, int>> pairs(size(moved) * size(fixed));
                 size_t cnt = 0;
                 for (auto i : moved)
@@ -815,7 +2799,52 @@ template <typename Tpairpot> class NonbondedCached : public Nonbonded<Tpairpot>
     void sync(Energybase *basePtr, Change &change) override {
         auto other = dynamic_cast<decltype(this)>(basePtr);
         assert(other);
-        if (change.all || change.dV)
+        base::sync(basePtr, change);
+        /*
+         * After a partial change, the trial cache is untouched, so the old (accepted) state
+         * updates its own cache: from the energy difference of the touched pairs if both
+         * states evaluated them, or else by recalculating the pairs. Whether the change is
+         * partial is derived from `change` since `energy()` may have been skipped for this
+         * term, e.g. when an earlier term rejected the move. When rejecting, the trial state
+         * copies the touched pairs from the old state as for other changes.
+         */
+        if (base::key == Energybase::OLD and isPartial(change)) {
+            bool known = partial and other->partial and partials.size() == other->partials.size();
+            for (size_t k = 0; known and k < partials.size(); k++)
+                known = partials[k].i == other->partials[k].i and partials[k].j == other->partials[k].j;
+            if (known)
+                for (size_t k = 0; k < partials.size(); k++) {
+                    auto &a = partials[k];        // this state
+                    auto &b = other->partials[k]; // other state
+                    if (b.cut)
+                        set(a.i, a.j, 0);
+                    else if (a.cut)
+                        set(a.i, a.j, full(spc.groups[a.i], spc.groups[a.j]));
+                    else
+                        set(a.i, a.j, get(a.i, a.j) + float(b.u - a.u));
+                }
+            else
+                for (auto &d : change.groups)
+                    for (int j = 0; j < int(spc.groups.size()); j++)
+                        if (j != d.index)
+                            set(std::min(d.index, j), std::max(d.index, j), full(spc.groups[d.index], spc.groups[j]));
+        } else if (sparse) {
+            if (change.all || change.dV)
+                rows = other->rows;
+            else
+                for (auto &d : change.groups) { // copy only touched rows and their mirror entries
+                    auto &row = rows[d.index];
+                    auto &src = other->rows[d.index];
+                    for (auto &e : row) {
+                        auto it = find(src, e.first);
+                        if (it == src.end() or it->first != e.first)
+                            set(rows[e.first], d.index, 0);
+                    }
+                    for (auto &e : src)
+                        set(rows[e.first], d.index, e.second);
+                    row = src;
+                }
+        } else if (change.all || change.dV)
             cache.triangularView<Eigen::StrictlyUpper>() =
                 (other->cache).template triangularView<Eigen::StrictlyUpper>();
         else
@@ -825,15 +2854,417 @@ template <typename Tpairpot> class NonbondedCached : public Nonbonded<Tpairpot>
                 for (size_t i = d.index + 1; i < base::spc.groups.size(); i++)
                     cache(d.index, i) = other->cache(d.index, i);
             }
+        partial = other->partial = false; // partial energies are used once
+        partials.clear();
+        other->partials.clear();
     } //!< Copy energy matrix from other
+
+    bool hasDelta(const Change &) const override { return false; } //!< the cache is updated by `energy()`
+
+    void to_json(json &j) const override {
+        base::to_json(j);
+        if (internal)
+            j["internal"] = true;
+        if (sparse) {
+            size_t n = 0;
+            for (auto &row : rows)
+                n += row.size();
+            j["sparse"] = true;
+            j["cached pairs"] = n / 2;
+        }
+    }
 };    //!< Nonbonded with cached energies (Energy Matrix)
 
+#ifdef DOCTEST_LIBRARY_INCLUDED
+TEST_CASE("[Faunus] NonbondedCached - sparse") {
+    using doctest::Approx;
+    auto atoms_backup = atoms;
+    auto molecules_backup = molecules;
+    atoms = R"([{"A": {"sigma": 2.0}}])"_json.get<decltype(atoms)>();
+    molecules = R"([{"dimer": {"structure": [{"A": [0, 0, 0]}, {"A": [1, 0, 0]}]}}])"_json.get<decltype(molecules)>();
+
+    Tspace spc;
+    spc.geo = R"({"type": "cuboid", "length": 60})"_json;
+    for (int n = 0; n < 80; n++) {
+        Tspace::Tpvec p(2);
+        p[0].id = p[1].id = 0;
+        spc.geo.randompos(p[0].pos, Faunus::random);
+        p[1].pos = p[0].pos + Point(1, 0, 0);
+        spc.geo.boundary(p[1].pos);
+        p[0].charge = 1;
+        p[1].charge = (n % 2 == 0) ? 1 : -1;
+        spc.push_back(0, p);
+    }
+
+    json j = R"({"coulomb": {"type": "plain", "epsr": 1, "cutoff": 100}, "cutoff_g2g": 15})"_json;
+    NonbondedCached<Potential::CoulombGalore> dense_new(j, spc), dense_old(j, spc);
+    j["sparse"] = true;
+    NonbondedCached<Potential::CoulombGalore> sparse_new(j, spc), sparse_old(j, spc);
+    dense_new.key = sparse_new.key = Energybase::NEW;
+    dense_old.key = sparse_old.key = Energybase::OLD;
+
+    json out;
+    sparse_new.to_json(out);
+    CHECK(out.at("cached pairs").get<int>() > 0);
+    CHECK(out.at("cached pairs").get<int>() < 80 * 79 / 2);
+
+    Change change;
+    change.all = true;
+    double u = dense_new.energy(change);
+    CHECK(u != 0);
+    CHECK(u == Approx(sparse_new.energy(change)));
+    CHECK(u == Approx(sparse_old.energy(change)));
+    CHECK(u == Approx(dense_old.energy(change)));
+
+    for (auto moved : std::vector<std::vector<int>>({{3}, {2, 5, 40}, {7}})) {
+        change.clear();
+        for (int i : moved) {
+            Change::data d;
+            d.index = i;
+            d.all = true;
+            change.groups.push_back(d);
+            spc.groups[i].translate(Point(4, -3, 2), spc.geo.getBoundaryFunc());
+        }
+        double uold = dense_old.energy(change);
+        CHECK(uold == Approx(sparse_old.energy(change)));
+        u = dense_new.energy(change);
+        CHECK(u == Approx(sparse_new.energy(change)));
+        CHECK(u != Approx(uold));
+        dense_old.sync(&dense_new, change);
+        sparse_old.sync(&sparse_new, change);
+        CHECK(u == Approx(dense_old.energy(change)));
+        CHECK(u == Approx(sparse_old.energy(change)));
+    }
+
+    change.clear();
+    change.all = true;
+    CHECK(dense_new.energy(change) == Approx(sparse_old.energy(change)));
+
+    atoms = atoms_backup;
+    molecules = molecules_backup;
+}
+
+TEST_CASE("[Faunus] NonbondedCached - partial changes") {
+    using doctest::Approx;
+    auto atoms_backup = atoms;
+    auto molecules_backup = molecules;
+    atoms = R"([{"A": {"sigma": 2.0}}])"_json.get<decltype(atoms)>();
+    molecules = R"([{"trimer": {"structure": [{"A": [0, 0, 0]}, {"A": [2, 0, 0]}, {"A": [4, 0, 0]}]}},
+                    {"salt": {"atoms": ["A"], "atomic": true}}])"_json.get<decltype(molecules)>();
+
+    Tspace spc1, spc2; // old and new states
+    spc1.geo = R"({"type": "cuboid", "length": 50})"_json;
+    for (int n = 0; n < 30; n++) {
+        Tspace::Tpvec p(3);
+        Point cm;
+        spc1.geo.randompos(cm, Faunus::random);
+        for (int k = 0; k < 3; k++) {
+            p[k].id = 0;
+            p[k].charge = (n % 2 == 0) ? 1 : -1;
+            p[k].pos = cm + Point(2 * k - 2, 0, 0);
+            spc1.geo.boundary(p[k].pos);
+        }
+        spc1.push_back(0, p);
+    }
+    Tspace::Tpvec salt(20);
+    for (size_t k = 0; k < salt.size(); k++) {
+        salt[k].id = 0;
+        salt[k].charge = (k % 2 == 0) ? 1 : -1;
+        spc1.geo.randompos(salt[k].pos, Faunus::random);
+    }
+    spc1.push_back(1, salt);
+    spc1.groups.back().resize(15); // last five ions are inactive
+
+    Change change;
+    change.all = true;
+    spc2.sync(spc1, change);
+
+    json j = R"({"coulomb": {"type": "plain", "epsr": 1, "cutoff": 100}, "cutoff_g2g": 15, "internal": true})"_json;
+    Nonbonded<Potential::CoulombGalore> brute1(j, spc1), brute2(j, spc2);
+    NonbondedCached<Potential::CoulombGalore> dense1(j, spc1), dense2(j, spc2);
+    j["sparse"] = true;
+    NonbondedCached<Potential::CoulombGalore> sparse1(j, spc1), sparse2(j, spc2);
+    dense1.key = sparse1.key = Energybase::OLD;
+    dense2.key = sparse2.key = Energybase::NEW;
+
+    // total energy now includes internal energies
+    CHECK(brute1.energy(change) == Approx(dense1.energy(change)));
+    CHECK(brute1.energy(change) == Approx(sparse1.energy(change)));
+
+    auto trial = [&](bool accept) {
+        double du = brute2.energy(change) - brute1.energy(change);
+        CHECK(du == Approx(dense2.energy(change) - dense1.energy(change)));
+        CHECK(du == Approx(sparse2.energy(change) - sparse1.energy(change)));
+        if (accept) {
+            spc1.sync(spc2, change);
+            dense1.sync(&dense2, change);
+            sparse1.sync(&sparse2, change);
+        } else {
+            spc2.sync(spc1, change);
+            dense2.sync(&dense1, change);
+            sparse2.sync(&sparse1, change);
+        }
+    };
+
+    // single atom moves in molecules and in the atomic group
+    for (int n = 0; n < 40; n++) {
+        change.clear();
+        Change::data d;
+        d.index = (n % 4 == 0) ? 30 : n % 30;
+        d.internal = true;
+        d.atoms = {n % 3};
+        change.groups.push_back(d);
+        Point &pos = (spc2.groups[d.index].begin() + d.atoms[0])->pos;
+        pos += 0.8 * ranunit(Faunus::random);
+        spc2.geo.boundary(pos);
+        trial(n % 3 != 0);
+    }
+
+    // deactivate molecule, then insert and delete ions
+    change.clear();
+    change.dN = true;
+    Change::data d;
+    d.index = 4;
+    d.all = true;
+    d.internal = true;
+    d.atoms = {0, 1, 2};
+    change.groups.push_back(d);
+    spc2.groups[4].resize(0);
+    trial(true);
+
+    change.groups[0].index = 30;
+    change.groups[0].all = false;
+    change.groups[0].atoms = {15, 16};
+    spc2.groups[30].resize(17);
+    trial(true);
+    spc2.groups[30].resize(15);
+    trial(false);
+    spc2.groups[30].resize(15);
+    trial(true);
+
+    // partial move, then a rejected molecule move where the trial energy is never evaluated,
+    // as when an earlier energy term stops the summation
+    change.clear();
+    change.groups.resize(1);
+    change.groups[0].index = 30;
+    change.groups[0].atoms = {3};
+    (spc2.groups[30].begin() + 3)->pos += Point(1, 0, 0);
+    spc2.geo.boundary((spc2.groups[30].begin() + 3)->pos);
+    trial(true);
+    change.groups[0].index = 7;
+    change.groups[0].atoms.clear();
+    change.groups[0].all = true;
+    spc2.groups[7].translate(Point(3, 0, 0), spc2.geo.getBoundaryFunc());
+    dense1.energy(change);
+    sparse1.energy(change);
+    spc2.sync(spc1, change);
+    CHECK_NOTHROW(dense2.sync(&dense1, change));
+    CHECK_NOTHROW(sparse2.sync(&sparse1, change));
+
+    // accepted partial move where only the trial state evaluated the change
+    change.groups[0].index = 30;
+    change.groups[0].all = false;
+    change.groups[0].atoms = {4};
+    (spc2.groups[30].begin() + 4)->pos += Point(0, 1, 0);
+    spc2.geo.boundary((spc2.groups[30].begin() + 4)->pos);
+    dense2.energy(change);
+    sparse2.energy(change);
+    spc1.sync(spc2, change);
+    dense1.sync(&dense2, change);
+    sparse1.sync(&sparse2, change);
+
+    change.clear();
+    change.all = true;
+    CHECK(brute1.energy(change) == Approx(dense1.energy(change)));
+    CHECK(brute1.energy(change) == Approx(sparse1.energy(change)));
+    CHECK(brute2.energy(change) == Approx(dense2.energy(change)));
+    CHECK(brute2.energy(change) == Approx(sparse2.energy(change)));
+
+    atoms = atoms_backup;
+    molecules = molecules_backup;
+}
+
+TEST_CASE("[Faunus] Bonded - index") {
+    using doctest::Approx;
+    auto atoms_backup = atoms;
+    auto molecules_backup = molecules;
+    atoms = R"([{"A": {"sigma": 2.0}}])"_json.get<decltype(atoms)>();
+    molecules = R"([{"dimer": {"structure": [{"A": [0, 0, 0]}, {"A": [2, 0, 0]}],
+                               "bondlist": [{"harmonic": {"index": [0, 1], "k": 1, "req": 1}}]}}])"_json
+                    .get<decltype(molecules)>();
+
+    Tspace spc;
+    spc.geo = R"({"type": "cuboid", "length": 40})"_json;
+    for (int n = 0; n < 3; n++) {
+        Tspace::Tpvec p(2);
+        for (int k = 0; k < 2; k++) {
+            p[k].id = 0;
+            p[k].pos = Point(2 * k, 4 * n, 0);
+        }
+        spc.push_back(0, p);
+    }
+    // inter-molecular bond between the second particle of molecule 0 and the first of molecule 1
+    Bonded bonded(R"({"bondlist": [{"harmonic": {"index": [1, 2], "k": 2, "req": 0}}]})"_json, spc);
+
+    double kJ = 1.0_kJmol; // harmonic energies are 0.5 k (r - req)^2 in kJ/mol
+    Change all;
+    all.all = true;
+    CHECK(bonded.energy(all) == Approx((3 * 0.5 + 0.5 * 2 * 20) * kJ));
+
+    Change change; // single particle in molecule 0
+    Change::data d;
+    d.index = 0;
+    d.internal = true;
+    d.atoms = {1};
+    change.groups.push_back(d);
+    CHECK(bonded.energy(change) == Approx((0.5 + 20) * kJ));
+
+    double u_partial = bonded.energy(change), u_full = bonded.energy(all);
+    spc.p[1].pos.x() += 0.5;
+    CHECK(bonded.energy(change) - u_partial == Approx(bonded.energy(all) - u_full));
+
+    change.groups[0].index = 2; // molecule 2 has no inter-molecular bonds
+    CHECK(bonded.energy(change) == Approx(0.5 * kJ));
+
+    change.groups[0].internal = false; // rigid body moves skip intra-molecular bonds
+    change.groups[0].all = true;
+    change.groups[0].index = 1;
+    CHECK(bonded.energy(change) == Approx(0.5 * 2 * (2.5 * 2.5 + 16) * kJ));
+
+    // bonds to deactivated groups are ignored
+    auto &g = spc.groups[1];
+    g.deactivate(g.begin(), g.end());
+    CHECK(bonded.energy(change) == Approx(0));
+    CHECK(bonded.energy(all) == Approx((0.5 * 1.5 * 1.5 + 0.5) * kJ));
+    g.activate(g.inactive().begin(), g.inactive().end());
+    CHECK(bonded.energy(all) == Approx((0.5 * 1.5 * 1.5 + 1 + 0.5 * 2 * (2.5 * 2.5 + 16)) * kJ));
+
+    atoms = atoms_backup;
+    molecules = molecules_backup;
+}
+
+TEST_CASE("[Faunus] Energy - delta") {
+    using doctest::Approx;
+    auto atoms_backup = atoms;
+    auto molecules_backup = molecules;
+    atoms = R"([{"A": {"sigma": 2.0}}])"_json.get<decltype(atoms)>();
+    molecules = R"([{"trimer": {"structure": [{"A": [0, 0, 0]}, {"A": [2, 0, 0]}, {"A": [4, 0, 0]}],
+                                "bondlist": [{"harmonic": {"index": [0, 1], "k": 1, "req": 2}},
+                                             {"harmonic": {"index": [1, 2], "k": 1, "req": 2}}]}},
+                    {"salt": {"atoms": ["A"], "atomic": true}}])"_json.get<decltype(molecules)>();
+
+    Tspace spc1, spc2; // old and trial states
+    spc1.geo = R"({"type": "cuboid", "length": 40})"_json;
+    for (int n = 0; n < 20; n++) {
+        Tspace::Tpvec p(3);
+        Point cm;
+        spc1.geo.randompos(cm, Faunus::random);
+        for (int k = 0; k < 3; k++) {
+            p[k].id = 0;
+            p[k].charge = (n % 2 == 0) ? 1 : -1;
+            p[k].pos = cm + Point(2 * k - 2, 0, 0);
+            spc1.geo.boundary(p[k].pos);
+        }
+        spc1.push_back(0, p);
+    }
+    Tspace::Tpvec salt(100);
+    for (size_t k = 0; k < salt.size(); k++) {
+        salt[k].id = 0;
+        salt[k].charge = (k % 2 == 0) ? 1 : -1;
+        spc1.geo.randompos(salt[k].pos, Faunus::random);
+    }
+    spc1.push_back(1, salt);
+
+    Change change;
+    change.all = true;
+    spc2.sync(spc1, change);
+
+    json j = R"({"coulomb": {"type": "plain", "epsr": 1, "cutoff": 12}, "cutoff_g2g": 14, "arrays": false})"_json;
+    Nonbonded<Potential::CoulombGalore> nb1(j, spc1), nb2(j, spc2);
+    j["arrays"] = true;
+    Nonbonded<Potential::CoulombGalore> arrays1(j, spc1), arrays2(j, spc2);
+    Bonded bonded1(json::object(), spc1), bonded2(json::object(), spc2);
+    CHECK(not nb2.hasDelta(change));
+
+    auto trial = [&](bool accept) {
+        CHECK(nb2.hasDelta(change));
+        CHECK(bonded2.hasDelta(change));
+        double du = nb2.energy(change) - nb1.energy(change);
+        CHECK(du == Approx(nb2.delta(change, spc1, spc2)));
+        CHECK(du == Approx(arrays2.delta(change, spc1, spc2)));
+        du = bonded2.energy(change) - bonded1.energy(change);
+        CHECK(du == Approx(bonded2.delta(change, spc1, spc2)).epsilon(1e-9));
+        if (accept)
+            spc1.sync(spc2, change);
+        else
+            spc2.sync(spc1, change);
+    };
+    auto displace = [&](int group, int atom) {
+        Point &pos = (spc2.groups[group].begin() + atom)->pos;
+        pos += 1.5 * ranunit(Faunus::random);
+        spc2.geo.boundary(pos);
+    };
+
+    for (int n = 0; n < 30; n++) {
+        change.clear();
+        Change::data d;
+        d.internal = true;
+        switch (n % 4) {
+        case 0: // single ion
+            d.index = 20;
+            d.atoms = {n};
+            displace(d.index, d.atoms[0]);
+            break;
+        case 1: // single atom in molecule
+            d.index = n % 20;
+            d.atoms = {2};
+            displace(d.index, 2);
+            break;
+        case 2: // subset of molecule
+            d.index = n % 20;
+            d.atoms = {0, 2};
+            displace(d.index, 0);
+            displace(d.index, 2);
+            break;
+        case 3: // whole molecule
+            d.index = n % 20;
+            d.all = true;
+            for (int k = 0; k < 3; k++)
+                displace(d.index, k);
+            spc2.groups[d.index].cm = spc2.groups[d.index].begin()->pos;
+            break;
+        }
+        change.groups.push_back(d);
+        trial(n % 3 != 0);
+    }
+
+    // two rigid molecules
+    change.clear();
+    for (int i : {3, 8}) {
+        Change::data d;
+        d.index = i;
+        d.all = true;
+        change.groups.push_back(d);
+        spc2.groups[i].translate(Point(7, 1, -4), spc2.geo.getBoundaryFunc());
+    }
+    trial(true);
+
+    atoms = atoms_backup;
+    molecules = molecules_backup;
+}
+#endif
+
 #ifdef ENABLE_POWERSASA
-/*
- * @todo:
- * - can only a subset of sasa be calculated? Note that it's the
- *   `update_coord()` function that takes up most time.
- * - delegate to GPU? In the PowerSasa paper this is mentioned
+/**
+ * @brief SASA energy from transfer free energies
+ *
+ * The surface area of a particle depends only on the probe-inflated spheres
+ * that overlap it. Overlapping neighbours are therefore kept in a cell list and
+ * per particle lists so that, after a partial move, only the moved particles and
+ * their old and new neighbours are recalculated. Each of these is evaluated with
+ * PowerSasa on the small cluster formed by the particle and its neighbours.
+ * Per particle areas are synchronised between the trial and accepted states by copying
+ * the entries touched since the last `sync()`.
  */
 class SASAEnergy : public Energybase {
   public:
@@ -845,17 +3276,24 @@ class SASAEnergy : public Energybase {
     double probe;            // sasa probe radius (angstrom)
     double conc = 0;         // co-solute concentration (mol/l)
     Average<double> avgArea; // average surface area
-    std::shared_ptr<POWERSASA::PowerSasa<float, Point>> ps = nullptr;
 
-    void updateSASA(const Tpvec &p);
+    std::array<bool, 3> pbc = {{true, true, true}}; // periodic directions
+    bool celllist_ready = false;                  // false if the geometry or box does not allow a cell list
+    Point celllist_box = {0, 0, 0};               // box dimensions for which the cell list was built
+    CellList<> celllist;                          // active particles in cells at least one sphere diameter wide
+    std::vector<int> groupOf;                     // group index of each particle
+    std::vector<std::vector<int>> neighbours;     // particles with spheres overlapping that of each particle
+    std::vector<int> updated;                     // particles recalculated since the last `sync()`
+    std::vector<char> isupdated;                  // flags particles in `updated`
+
+    inline bool isActive(int n) const {
+        return groupOf[n] >= 0 and spc.p.begin() + n < spc.groups[groupOf[n]].end();
+    }
+    void build();                                    // all particles from scratch (complexity: N)
+    void findNeighbours(int i, std::vector<int> &index) const; // active particles overlapping particle `i`
+    void updateParticle(int i);                      // neighbour list and area of particle `i`
+    void updateSASA(const Change &change);           // particles affected by `change`
     void to_json(json &j) const override;
-
-    /*
-     * @note
-     * This is not enough as the PowerSasa object contains data
-     * that also need syncing. It works due to the `update` (expensive!)
-     * call in `energy`.
-     */
     void sync(Energybase *basePtr, Change &c) override;
 
   public:
@@ -863,6 +3301,86 @@ class SASAEnergy : public Energybase {
     void init() override;
     double energy(Change &) override;
 }; //!< SASA energy from transfer free energies
+
+#ifdef DOCTEST_LIBRARY_INCLUDED
+TEST_CASE("[Faunus] SASAEnergy - incremental") {
+    using doctest::Approx;
+    auto atoms_backup = atoms;
+    auto molecules_backup = molecules;
+    atoms = R"([{"A": {"sigma": 4.0, "tfe": 1.0}}])"_json.get<decltype(atoms)>();
+    molecules = R"([{"salt": {"atoms": ["A"], "atomic": true}}])"_json.get<decltype(molecules)>();
+
+    Tspace spc1, spc2; // accepted and trial states
+    spc1.geo = R"({"type": "cuboid", "length": 30})"_json;
+    Tspace::Tpvec p(60);
+    for (auto &i : p) {
+        i.id = 0;
+        spc1.geo.randompos(i.pos, Faunus::random);
+    }
+    spc1.push_back(0, p);
+    Change all;
+    all.all = true;
+    spc2.sync(spc1, all);
+
+    json j = R"({"molarity": 1.0, "radius": 1.4})"_json;
+    SASAEnergy sasa1(j, spc1), sasa2(j, spc2);
+    Energybase &base1 = sasa1, &base2 = sasa2;
+    for (int n = 0; n < 20; n++) {
+        Change change;
+        Change::data d;
+        d.index = 0;
+        d.internal = true;
+        d.atoms = {n, n + 20};
+        for (int i : d.atoms) {
+            spc2.p[i].pos += 2.0 * ranunit(Faunus::random);
+            spc2.geo.boundary(spc2.p[i].pos);
+        }
+        change.groups.push_back(d);
+        double u = sasa2.energy(change);
+        SASAEnergy fresh(j, spc2); // recalculated from scratch
+        CHECK(u == Approx(fresh.energy(all)));
+        if (n % 2 == 0) { // accept
+            spc1.sync(spc2, change);
+            base1.sync(&base2, change);
+        } else { // reject
+            spc2.sync(spc1, change);
+            base2.sync(&base1, change);
+        }
+        CHECK(sasa1.sasa == sasa2.sasa);
+    }
+
+    // atomic deletions as in speciation: a random atom is swapped with the last active atom
+    // in both states, only the deactivated slot is listed, and the old state is not evaluated
+    for (int n = 0; n < 10; n++) {
+        for (auto spc : {&spc1, &spc2})
+            std::iter_swap(spc->groups.front().begin() + n, spc->groups.front().end() - 1);
+        auto &g = spc2.groups.front();
+        Change change;
+        change.dN = true;
+        Change::data d;
+        d.index = 0;
+        d.internal = true;
+        d.dNatomic = true;
+        d.atoms = {int(g.size()) - 1};
+        g.deactivate(g.end() - 1, g.end());
+        change.groups.push_back(d);
+        double u = sasa2.energy(change);
+        CHECK(u == Approx(SASAEnergy(j, spc2).energy(all)));
+        if (n % 2 == 0) { // accept
+            spc1.sync(spc2, change);
+            base1.sync(&base2, change);
+        } else { // reject
+            spc2.sync(spc1, change);
+            base2.sync(&base1, change);
+        }
+        CHECK(sasa1.sasa == sasa2.sasa);
+        Change none;
+        CHECK(sasa1.energy(none) == Approx(SASAEnergy(j, spc1).energy(all)));
+    }
+    atoms = atoms_backup;
+    molecules = molecules_backup;
+}
+#endif
 #endif
 
 struct Example2D : public Energybase {
@@ -876,16 +3394,244 @@ class Hamiltonian : public Energybase, public BasePointerVector<Energybase> {
     double maxenergy = pc::infty; //!< Maximum allowed energy change
     void to_json(json &j) const override;
     void addEwald(const json &j, Tspace &spc); //!< Adds an instance of reciprocal space Ewald energies (if appropriate)
+    void tuneEwald(json &j, Tspace &spc);      //!< Sets Ewald parameters for a target accuracy (if requested)
     void
     addSelfEnergy(const json &j,
                   Tspace &spc); //!< Adds an instance of the self term of the electrostatic potential (if appropriate)
 
+    /*
+     * The ledger holds energies of the accepted state so that they need not be
+     * recalculated. `SYSTEM` terms store a single value; `GROUP` terms store one value
+     * per group, valid for changes where all atoms of the group are touched. Values come
+     * from the trial state when a move is accepted, see `sync()`. Terms with `NOLEDGER`,
+     * e.g. `Penalty` whose energy changes as the penalty function is updated, are always
+     * recalculated.
+     */
+    bool ledger_enable = false;
+    std::vector<double> last;                         // energy of each term from last call to `energy()`
+    std::vector<bool> last_valid;                     // false if the term was skipped in last call
+    std::vector<double> ledger_system;                // accepted energy of `SYSTEM` terms
+    std::vector<bool> ledger_system_valid;            // true if entry in `ledger_system` is known
+    std::vector<std::map<int, double>> ledger_group; // accepted energy of `GROUP` terms for each group index
+    double ledgerTerm(size_t i, Change &change);      // accepted energy of i'th term, from ledger if possible
+    void record(size_t i, Change &change, double u);  // store energy of i'th term in the accepted state
+    void resizeLedger();                              // match ledger to number of terms; on construction and `init()`
+
+    /*
+     * With adaptive ordering, the trial state evaluates terms in order of increasing
+     * expected cost per rejection, i.e. the time spent in a term divided by the number of
+     * times it returned infinity. Statistics and ordering are kept for each move.
+     */
+    struct TermStatistics {
+        double time = 0;            // seconds spent in term
+        unsigned long infcnt = 0;   // number of times the term returned infinity
+    };
+    struct Ordering {
+        std::vector<size_t> order;        // term indices in order of evaluation
+        std::vector<TermStatistics> stat; // statistics for each term
+        unsigned long cnt = 0;            // number of calls to `energy()`
+    };
+    bool adaptive_enable = false;
+    unsigned long adaptive_interval = 1000;   // number of evaluations between reordering
+    std::map<std::string, Ordering> orderings; // ordering for each move
+    Ordering *ordering = nullptr;             // current ordering, see `select()`
+    void reorder(Ordering &o);                // sort terms by expected cost per rejection
+
   public:
+    bool delta_enable = false; //!< Evaluate energy changes in a single pass where supported?
+    bool concurrent_enable = false; //!< Evaluate trial and accepted states on two threads?
+    bool earlyreject_enable = false; //!< Draw the Metropolis random number first and stop at `Change::umax`?
     Hamiltonian(Tspace &spc, const json &j);
     double energy(Change &change) override; //!< Energy due to changes
+    double ledgerEnergy(Change &change);    //!< As `energy()` but for the accepted state, reusing known energies
+    double delta(Change &change, Hamiltonian &old, const Tspace &oldspc,
+                 const Tspace &trialspc); //!< Energy change from this (trial) and old Hamiltonians
     void init() override;
     void sync(Energybase *basePtr, Change &change) override;
+    void select(const std::string &move); //!< Use term ordering for the given move (adaptive ordering only)
+    std::map<std::string, std::vector<std::string>> termOrder() const; //!< Names of terms in order of evaluation, for each move
 }; //!< Aggregates and sum energy terms
 
+#ifdef DOCTEST_LIBRARY_INCLUDED
+TEST_CASE("[Faunus] Hamiltonian - ledger") {
+    using doctest::Approx;
+    auto atoms_backup = atoms;
+    auto molecules_backup = molecules;
+    atoms = R"([{"A": {"sigma": 2.0}}])"_json.get<decltype(atoms)>();
+    molecules = R"([{"dimer": {"structure": [{"A": [0, 0, 0]}, {"A": [2, 0, 0]}]}}])"_json.get<decltype(molecules)>();
+
+    Tspace spc1, spc2; // old and trial states
+    spc1.geo = R"({"type": "cuboid", "length": 40})"_json;
+    for (int n = 0; n < 10; n++) {
+        Tspace::Tpvec p(2);
+        Point cm(3 * n - 15, 8, 0); // all outside the confining sphere
+        for (int k = 0; k < 2; k++) {
+            p[k].id = 0;
+            p[k].pos = cm + Point(2 * k - 1, 0, 0);
+            spc1.geo.boundary(p[k].pos);
+        }
+        spc1.push_back(0, p);
+    }
+    Change change;
+    change.all = true;
+    spc2.sync(spc1, change);
+
+    json j = R"({"energy": [{"confine": {"type": "sphere", "radius": 5, "k": 1, "molecules": ["dimer"]}},
+                            {"ledger": true}]})"_json;
+    Hamiltonian pot1(spc1, j), pot2(spc2, j);
+    pot1.key = Energybase::OLD;
+    pot2.key = Energybase::NEW;
+    CHECK(pot1.ledgerEnergy(change) == Approx(pot1.energy(change)));
+
+    Change::data d;
+    d.index = 3;
+    d.all = true;
+    change.clear();
+    change.groups.push_back(d);
+    double uold = pot1.ledgerEnergy(change);
+    CHECK(uold == Approx(pot1.energy(change)));
+
+    // accepted move; the old energy is taken from the trial state
+    spc2.groups[3].translate(Point(6, 1, -2), spc2.geo.getBoundaryFunc());
+    double unew = pot2.energy(change);
+    CHECK(unew != Approx(uold));
+    spc1.sync(spc2, change);
+    pot1.sync(&pot2, change);
+    spc1.groups[3].translate(Point(1, 1, 1), spc1.geo.getBoundaryFunc()); // hidden from the ledger
+    CHECK(pot1.ledgerEnergy(change) == unew);
+    CHECK(pot1.energy(change) != Approx(unew));
+
+    // partial and volume changes are never taken from the ledger
+    change.groups[0].all = false;
+    change.groups[0].atoms = {0, 1};
+    CHECK(pot1.ledgerEnergy(change) == Approx(pot1.energy(change)));
+    change.clear();
+    change.dV = true;
+    CHECK(pot1.ledgerEnergy(change) == Approx(pot1.energy(change)));
+
+    atoms = atoms_backup;
+    molecules = molecules_backup;
+}
+
+TEST_CASE("[Faunus] Hamiltonian - adaptive order") {
+    auto atoms_backup = atoms;
+    auto molecules_backup = molecules;
+    atoms = R"([{"A": {"sigma": 2.0}}])"_json.get<decltype(atoms)>();
+    molecules = R"([{"dimer": {"structure": [{"A": [0, 0, 0]}, {"A": [2, 0, 0]}]}}])"_json.get<decltype(molecules)>();
+
+    Tspace spc;
+    spc.geo = R"({"type": "cuboid", "length": 40})"_json;
+    for (int n = 0; n < 10; n++) {
+        Tspace::Tpvec p(2);
+        Point cm(3 * n - 15, 8, 0); // all outside the confining sphere
+        for (int k = 0; k < 2; k++) {
+            p[k].id = 0;
+            p[k].pos = cm + Point(2 * k - 1, 0, 0);
+            spc.geo.boundary(p[k].pos);
+        }
+        spc.push_back(0, p);
+    }
+
+    json j = R"({"energy": [{"customexternal": {"function": "x*x", "molecules": ["dimer"]}},
+                            {"confine": {"type": "sphere", "radius": 5, "k": "inf", "molecules": ["dimer"]}},
+                            {"adaptiveorder": true}]})"_json;
+    Hamiltonian pot(spc, j);
+    pot.key = Energybase::NEW;
+    CHECK(pot.termOrder().empty());
+
+    Change change;
+    Change::data d;
+    d.index = 3;
+    d.all = true;
+    change.groups.push_back(d);
+    pot.select("translate");
+    CHECK(pot.termOrder()["translate"] == std::vector<std::string>({"customexternal", "confine"}));
+    for (int n = 0; n < 1000; n++)
+        pot.energy(change);
+    CHECK(pot.energy(change) == pc::infty);
+    CHECK(pot.termOrder()["translate"] == std::vector<std::string>({"confine", "customexternal"}));
+
+    // each move has its own ordering
+    pot.select("rotate");
+    CHECK(pot.termOrder()["rotate"] == std::vector<std::string>({"customexternal", "confine"}));
+
+    atoms = atoms_backup;
+    molecules = molecules_backup;
+}
+
+TEST_CASE("[Faunus] ExternalPotential - partial changes") {
+    using doctest::Approx;
+    auto atoms_backup = atoms;
+    auto molecules_backup = molecules;
+    atoms = R"([{"A": {"sigma": 2.0}}])"_json.get<decltype(atoms)>();
+    molecules = R"([{"dimer": {"structure": [{"A": [0, 0, 0]}, {"A": [2, 0, 0]}]}},
+                    {"salt": {"atoms": ["A"], "atomic": true}}])"_json.get<decltype(molecules)>();
+
+    Tspace spc;
+    spc.geo = R"({"type": "cuboid", "length": 40})"_json;
+    for (int n = 0; n < 5; n++) {
+        Tspace::Tpvec p(2);
+        for (int k = 0; k < 2; k++) {
+            p[k].id = 0;
+            p[k].charge = (k == 0) ? 1 : -1;
+            p[k].pos = Point(6 * n - 12 + 2 * k, 3, 2 * n - 4);
+        }
+        spc.push_back(0, p);
+    }
+    Tspace::Tpvec salt(10);
+    for (int k = 0; k < 10; k++) {
+        salt[k].id = 0;
+        salt[k].charge = (k % 2 == 0) ? 1 : -1;
+        salt[k].pos = Point(4 * k - 18, -9, 1.5 * k - 6);
+    }
+    spc.push_back(1, salt);
+
+    json j = R"({"energy": [
+        {"confine": {"type": "cuboid", "low": [-8, -8, -8], "high": [8, 8, 8], "k": 1, "molecules": ["dimer", "salt"]}},
+        {"customexternal": {"function": "gouychapman", "molecules": ["dimer", "salt"],
+                            "constants": {"ionicstrength": 0.1, "epsr": 80, "phi0": 2, "zpos": -20}}}]})"_json;
+    Hamiltonian pot(spc, j);
+    Change all;
+    all.all = true;
+    double u = pot.energy(all);
+    CHECK(u != Approx(0));
+
+    // whole groups are summed in batches; single particles individually
+    double usum = 0;
+    for (size_t g = 0; g < spc.groups.size(); g++)
+        for (size_t i = 0; i < spc.groups[g].size(); i++) {
+            Change change;
+            Change::data d;
+            d.index = g;
+            d.atoms = {int(i)};
+            change.groups.push_back(d);
+            usum += pot.energy(change);
+        }
+    CHECK(usum == Approx(u));
+
+    // particle number changes evaluate only the listed groups and atoms
+    Change change;
+    change.dN = true;
+    Change::data d;
+    d.index = 2;
+    d.all = true;
+    d.internal = true;
+    d.atoms = {0, 1};
+    change.groups.push_back(d);
+    d.index = 5;
+    d.all = false;
+    d.atoms = {8, 9};
+    change.groups.push_back(d);
+    double uold = pot.energy(change);
+    spc.groups[2].deactivate(spc.groups[2].begin(), spc.groups[2].end());
+    spc.groups[5].deactivate(spc.groups[5].end() - 2, spc.groups[5].end());
+    CHECK(pot.energy(change) == Approx(0));
+    CHECK(pot.energy(all) == Approx(u - uold));
+
+    atoms = atoms_backup;
+    molecules = molecules_backup;
+}
+#endif
+
 } // namespace Energy
 } // namespace Faunus
@@ -5,12 +5,15 @@ namespace Energy {
 
 double ExternalPotential::_energy(const Group<Particle> &g) const {
     double u = 0;
-    if (molids.find(g.id) != molids.end()) {
+    if (molids.find(g.id) != molids.end() and not g.empty()) {
         if (COM and g.atomic == false) { // apply only to center of mass
             Particle cm;                 // fake particle representin molecule
             cm.charge = Geometry::monopoleMoment(g.begin(), g.end());
             cm.pos = g.cm;
             u = func(cm);
+        } else if (batch != nullptr) { // contiguous particle arrays
+            size_t first = std::distance(spc.p.begin(), g.begin());
+            u = batch(spc.arrays, first, first + g.size());
         } else {
             for (auto &p : g) {
                 u += func(p);
@@ -24,6 +27,7 @@ double ExternalPotential::_energy(const Group<Particle> &g) const {
 
 ExternalPotential::ExternalPotential(const json &j, Tspace &spc) : spc(spc) {
     name = "external";
+    ledger = GROUP; // energy of each group is independent of all other groups
     COM = j.value("com", false);
     _names = j.at("molecules").get<decltype(_names)>(); // molecule names
     auto _ids = names2ids(molecules, _names);           // names --> molids
@@ -34,7 +38,9 @@ ExternalPotential::ExternalPotential(const json &j, Tspace &spc) : spc(spc) {
 double ExternalPotential::energy(Change &change) {
     assert(func != nullptr);
     double u = 0;
-    if (change.dV or change.all or change.dN) {
+    if (batch != nullptr)
+        spc.updateArrays(change); // particle arrays used by `batch`
+    if (change.dV or change.all) {
         for (auto &g : spc.groups) { // check all groups
             u += _energy(g);
             if (std::isnan(u))
@@ -43,18 +49,25 @@ double ExternalPotential::energy(Change &change) {
     } else
         for (auto &d : change.groups) {
             auto &g = spc.groups.at(d.index); // check specified groups
-            if (d.all or COM)                 // check all atoms in group
-                u += _energy(g);              // _energy also checks for molecule id
-            else {                            // check only specified atoms in group
+            if (d.all or (COM and not g.atomic)) // check all atoms in group
+                u += _energy(g);                 // _energy also checks for molecule id
+            else {                               // check only specified atoms in group
                 if (molids.find(g.id) != molids.end())
                     for (auto i : d.atoms)
-                        u += func(*(g.begin() + i));
+                        if (i < int(g.size())) // atoms removed by `dN` are inactive
+                            u += func(*(g.begin() + i));
             }
             if (std::isnan(u))
                 break;
         }
     return u;
 }
+void ExternalPotential::init() {
+    if (batch != nullptr) { // keep particle arrays in sync, also on rejected moves
+        spc.arrays_enable = true;
+        spc.arrays.assign(spc.p);
+    }
+}
 void ExternalPotential::to_json(json &j) const {
     j["molecules"] = _names;
     j["com"] = COM;
@@ -64,6 +77,8 @@ Confine::Confine(const json &j, Tspace &spc) : ExternalPotential(j, spc) {
     name = "confine";
     k = value_inf(j, "k") * 1.0_kJmol; // get floating point; allow inf/-inf
     type = m.at(j.at("type"));
+    if (k >= 0)
+        umin = 0; // harmonic penalty outside the region
 
     if (type == sphere or type == cylinder) {
         radius = j.at("radius");
@@ -77,6 +92,18 @@ Confine::Confine(const json &j, Tspace &spc) : ExternalPotential(j, spc) {
                 return 0.5 * k * d2;
             return 0.0;
         };
+        batch = [&radius = radius, origo = origo, k = k, dir = dir](const ParticleArrays &a, size_t first,
+                                                                      size_t last) {
+            double u = 0, r2 = radius * radius;
+#pragma omp simd reduction(+ : u)
+            for (size_t i = first; i < last; i++) {
+                double dx = (origo.x() - a.x[i]) * dir.x(), dy = (origo.y() - a.y[i]) * dir.y(),
+                       dz = (origo.z() - a.z[i]) * dir.z();
+                double d2 = dx * dx + dy * dy + dz * dz - r2;
+                u += (d2 > 0) ? d2 : 0.0;
+            }
+            return (u > 0) ? 0.5 * k * u : 0.0;
+        };
 
         // If volume is scaled, also scale the confining radius by adding a trigger
         // to `Space::scaleVolume()`
@@ -98,7 +125,20 @@ Confine::Confine(const json &j, Tspace &spc) : ExternalPotential(j, spc) {
             for (int i = 0; i < 3; ++i)
                 if (d[i] > 0)
                     u += d[i] * d[i];
-            return 0.5 * k * u;
+            return (u > 0) ? 0.5 * k * u : 0.0; // avoid inf*0 for hard walls
+        };
+        batch = [low = low, high = high, k = k](const ParticleArrays &a, size_t first, size_t last) {
+            const double *r[3] = {a.x.data(), a.y.data(), a.z.data()};
+            double u = 0;
+            for (int d = 0; d < 3; d++) {
+                double lo = low[d], hi = high[d];
+#pragma omp simd reduction(+ : u)
+                for (size_t i = first; i < last; i++) {
+                    double below = std::max(lo - r[d][i], 0.0), above = std::max(r[d][i] - hi, 0.0);
+                    u += below * below + above * above;
+                }
+            }
+            return (u > 0) ? 0.5 * k * u : 0.0;
         };
     }
 }
@@ -129,6 +169,8 @@ ExternalAkesson::ExternalAkesson(const json &j, Tspace &spc) : ExternalPotential
     nstep = _j.at("nstep").get<unsigned int>();
     epsr = _j.at("epsr").get<double>();
     fixed = _j.value("fixed", false);
+    if (not fixed)
+        ledger = NOLEDGER; // potential is updated from accepted states in `energy()`
     nphi = _j.value("nphi", 10);
 
     halfz = 0.5 * spc.geo.getLength().z();
@@ -143,6 +185,12 @@ ExternalAkesson::ExternalAkesson(const json &j, Tspace &spc) : ExternalPotential
     load();
 
     func = [&phi = phi](const typename Tspace::Tparticle &p) { return p.charge * phi(p.pos.z()); };
+    batch = [&phi = phi](const ParticleArrays &a, size_t first, size_t last) {
+        double u = 0;
+        for (size_t i = first; i < last; i++)
+            u += a.charge[i] * phi(a.z[i]);
+        return u;
+    };
 
     if (not _j.empty()) // throw exception of unused/unknown keys are passed
         throw std::runtime_error("unused key(s) for '"s + name + "':\n" + _j.dump());
@@ -165,37 +213,61 @@ ExternalAkesson::~ExternalAkesson() {
         save();
 }
 
-std::function<double(const Particle &)> createGouyChapmanPotential(const json &j) {
-    double rho;
-    double c0 = j.at("ionicstrength").get<double>() * 1.0_molar; // assuming 1:1 salt, so c0=I
-    double lB = pc::lB(j.at("epsr").get<double>());
-    double k = 1 / (3.04 / sqrt(c0));   // hack!
-    double phi0 = j.value("phi0", 0.0); // Unitless potential = beta*e*phi0
-    if (std::fabs(phi0) > 1e-6)
-        rho = sqrt(2 * c0 / (pc::pi * lB)) * sinh(.5 * phi0); // Evans&Wennerstrom,Colloidal Domain p
-    // 138-140
-    else {
-        rho = 1.0 / j.value("qarea", 0.0);
-        if (rho > 1e9)
-            rho = j.at("rho");
-        phi0 = 2. * std::asinh(rho * std::sqrt(0.5 * lB * pc::pi / c0)); //[Evans..]
+/**
+ * @brief Gouy-Chapman potential energy of a charge at a given z-position; see `createGouyChapmanPotential()`
+ */
+class GouyChapman {
+    double k, phi0, gamma0, surface_z_pos;
+    bool linearize;
+
+  public:
+    GouyChapman(const json &j) {
+        double rho;
+        double c0 = j.at("ionicstrength").get<double>() * 1.0_molar; // assuming 1:1 salt, so c0=I
+        double lB = pc::lB(j.at("epsr").get<double>());
+        k = 1 / (3.04 / sqrt(c0));   // hack!
+        phi0 = j.value("phi0", 0.0); // Unitless potential = beta*e*phi0
+        if (std::fabs(phi0) > 1e-6)
+            rho = sqrt(2 * c0 / (pc::pi * lB)) * sinh(.5 * phi0); // Evans&Wennerstrom,Colloidal Domain p
+        // 138-140
+        else {
+            rho = 1.0 / j.value("qarea", 0.0);
+            if (rho > 1e9)
+                rho = j.at("rho");
+            phi0 = 2. * std::asinh(rho * std::sqrt(0.5 * lB * pc::pi / c0)); //[Evans..]
+        }
+        gamma0 = std::tanh(phi0 / 4); // assuming z=1  [Evans..]
+        surface_z_pos = j.value("zpos", 0.0);
+        linearize = j.value("linearize", false);
     }
-    double gamma0 = std::tanh(phi0 / 4); // assuming z=1  [Evans..]
-    double surface_z_pos = j.value("zpos", 0.0);
-    bool linearize = j.value("linearize", false);
 
-    // return gamma function for calculation of GC potential on single particle.
-    return [=](const Particle &p) {
-        if (p.charge != 0) {
-            double x = std::exp(-k * std::fabs(surface_z_pos - p.pos.z()));
+    inline double operator()(double charge, double z) const {
+        if (charge != 0) {
+            double x = std::exp(-k * std::fabs(surface_z_pos - z));
             if (linearize)
-                return p.charge * phi0 * x;
+                return charge * phi0 * x;
             else {
                 x = gamma0 * x;
-                return 2 * p.charge * std::log((1 + x) / (1 - x));
+                return 2 * charge * std::log((1 + x) / (1 - x));
             }
         }
         return 0.0;
+    }
+};
+
+std::function<double(const Particle &)> createGouyChapmanPotential(const json &j) {
+    GouyChapman gc(j);
+    // return gamma function for calculation of GC potential on single particle.
+    return [gc](const Particle &p) { return gc(p.charge, p.pos.z()); };
+}
+
+std::function<double(const ParticleArrays &, size_t, size_t)> createGouyChapmanBatch(const json &j) {
+    GouyChapman gc(j);
+    return [gc](const ParticleArrays &a, size_t first, size_t last) {
+        double u = 0;
+        for (size_t i = first; i < last; i++)
+            u += gc(a.charge[i], a.z[i]);
+        return u;
     };
 }
 
@@ -214,9 +286,10 @@ CustomExternal::CustomExternal(const json &j, Tspace &spc) : ExternalPotential(j
 
     // check of the custom potential match a name with a
     // predefined meaning.
-    if (name == "gouychapman")
+    if (name == "gouychapman") {
         func = createGouyChapmanPotential(_j);
-    else if (name == "something") {
+        batch = createGouyChapmanBatch(_j);
+    } else if (name == "something") {
         // add additional potential here
         // base::func = createSomeOtherPotential(_j);
     } else {
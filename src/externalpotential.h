@@ -12,26 +12,32 @@ namespace Energy {
  * list of molecules, either acting on individual
  * atoms or the mass-center. The specific energy
  * function, `func` is injected in derived classes.
+ * Derived classes may also inject `batch` which sums the energy
+ * of a contiguous range of particles in `Space::arrays`; it is
+ * used for whole groups and avoids a function call per particle.
  */
 class ExternalPotential : public Energybase {
   protected:
     typedef typename Tspace::Tpvec Tpvec;
+    typedef std::function<double(const ParticleArrays &, size_t, size_t)> BatchFunction;
     bool COM = false; // apply on center-of-mass
     Tspace &spc;
     std::set<int> molids;                                   // molecules to act upon
     std::function<double(const Particle &)> func = nullptr; // energy of single particle
+    BatchFunction batch = nullptr;                          // energy of particles [first:last) in `Space::arrays`
     std::vector<std::string> _names;
 
-    double _energy(const Group<Particle> &g) const; //!< External potential on a single particle
+    double _energy(const Group<Particle> &g) const; //!< External potential on all active particles in group
   public:
     ExternalPotential(const json &j, Tspace &spc);
 
     /*
-     * @todo The `dN` check is very inefficient
-     * as it calculates the external potential on *all*
-     * particles.
+     * Only groups and atoms listed in `change` are evaluated. This includes
+     * particle number changes (`dN`) where atoms beyond the active
+     * range of a group are removed and do not contribute.
      */
     double energy(Change &change) override;
+    void init() override;
     void to_json(json &j) const override;
 }; //!< Base class for external potentials, acting on particles
 
@@ -48,6 +54,11 @@ class ExternalPotential : public Energybase {
  */
 std::function<double(const Particle &)> createGouyChapmanPotential(const json &j);
 
+/**
+ * @brief As `createGouyChapmanPotential()` but summing over particles [first:last) in `Space::arrays`
+ */
+std::function<double(const ParticleArrays &, size_t, size_t)> createGouyChapmanBatch(const json &j);
+
 /**
  * @brief Custom external potential on molecules
  */
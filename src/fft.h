@@ -0,0 +1,122 @@
+#pragma once
+
+#include <complex>
+#include <vector>
+#include <cmath>
+#include <stdexcept>
+#include <algorithm>
+
+namespace Faunus {
+/**
+ * @brief Minimal, self-contained fast Fourier transform
+ *
+ * Iterative radix-2 transforms of complex data whose lengths are powers of two.
+ * The transform is unnormalised,
+ * \f$ F_m = \sum_{j=0}^{n-1} f_j e^{\pm 2\pi i m j/n} \f$, with the sign given by `sign`.
+ */
+namespace FFT {
+typedef std::complex<double> Tcomplex;
+
+inline bool isPowerOfTwo(size_t n) { return n > 0 and (n & (n - 1)) == 0; }
+
+inline size_t nextPowerOfTwo(size_t n) {
+    size_t m = 1;
+    while (m < n)
+        m <<= 1;
+    return m;
+} //!< Smallest power of two larger than or equal to `n`
+
+/** @brief In-place transform of `n` contiguous values */
+inline void fft(Tcomplex *f, size_t n, int sign = -1) {
+    if (not isPowerOfTwo(n))
+        throw std::runtime_error("fft: length must be a power of two");
+    for (size_t i = 1, j = 0; i < n; i++) { // bit reversal permutation
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1)
+            j ^= bit;
+        j ^= bit;
+        if (i < j)
+            std::swap(f[i], f[j]);
+    }
+    for (size_t len = 2; len <= n; len <<= 1) { // butterflies
+        double theta = sign * 2 * M_PI / len;
+        Tcomplex w1(std::cos(theta), std::sin(theta));
+        for (size_t i = 0; i < n; i += len) {
+            Tcomplex w(1, 0);
+            for (size_t j = 0; j < len / 2; j++) {
+                Tcomplex u = f[i + j], v = f[i + j + len / 2] * w;
+                f[i + j] = u + v;
+                f[i + j + len / 2] = u - v;
+                w *= w1;
+            }
+        }
+    }
+}
+
+/**
+ * @brief In-place transform of a three dimensional, row-major grid
+ *
+ * Element (i,j,k) is stored at `(i*n1 + j)*n2 + k`. Each dimension must be a power of two.
+ */
+inline void fft3(std::vector<Tcomplex> &f, size_t n0, size_t n1, size_t n2, int sign = -1) {
+    if (f.size() != n0 * n1 * n2)
+        throw std::runtime_error("fft: grid size mismatch");
+    std::vector<Tcomplex> line(std::max(n0, n1));
+    for (size_t i = 0; i < n0 * n1; i++) // contiguous along last dimension
+        fft(f.data() + i * n2, n2, sign);
+    for (size_t i = 0; i < n0; i++) // along middle dimension
+        for (size_t k = 0; k < n2; k++) {
+            for (size_t j = 0; j < n1; j++)
+                line[j] = f[(i * n1 + j) * n2 + k];
+            fft(line.data(), n1, sign);
+            for (size_t j = 0; j < n1; j++)
+                f[(i * n1 + j) * n2 + k] = line[j];
+        }
+    for (size_t j = 0; j < n1; j++) // along first dimension
+        for (size_t k = 0; k < n2; k++) {
+            for (size_t i = 0; i < n0; i++)
+                line[i] = f[(i * n1 + j) * n2 + k];
+            fft(line.data(), n0, sign);
+            for (size_t i = 0; i < n0; i++)
+                f[(i * n1 + j) * n2 + k] = line[i];
+        }
+}
+
+#ifdef DOCTEST_LIBRARY_INCLUDED
+TEST_CASE("[Faunus] FFT") {
+    using doctest::Approx;
+    CHECK(isPowerOfTwo(64));
+    CHECK(not isPowerOfTwo(48));
+    CHECK(nextPowerOfTwo(33) == 64);
+    CHECK(nextPowerOfTwo(32) == 32);
+
+    // compare with direct discrete Fourier transform
+    size_t n0 = 4, n1 = 2, n2 = 8;
+    std::vector<Tcomplex> f(n0 * n1 * n2), g;
+    for (size_t i = 0; i < f.size(); i++)
+        f[i] = Tcomplex(std::sin(i * 0.7), std::cos(i * i * 0.3));
+    g = f;
+    fft3(g, n0, n1, n2, 1);
+    for (size_t a = 0; a < n0; a++)
+        for (size_t b = 0; b < n1; b++)
+            for (size_t c = 0; c < n2; c++) {
+                Tcomplex F(0, 0);
+                for (size_t i = 0; i < n0; i++)
+                    for (size_t j = 0; j < n1; j++)
+                        for (size_t k = 0; k < n2; k++)
+                            F += f[(i * n1 + j) * n2 + k] *
+                                 std::polar(1.0, 2 * M_PI * (double(a * i) / n0 + double(b * j) / n1 + double(c * k) / n2));
+                CHECK(std::abs(g[(a * n1 + b) * n2 + c] - F) == Approx(0).epsilon(1e-10));
+            }
+
+    // forward and backward transforms multiply by the number of points
+    fft3(g, n0, n1, n2, -1);
+    for (size_t i = 0; i < f.size(); i++)
+        CHECK(std::abs(g[i] / double(f.size()) - f[i]) == Approx(0).epsilon(1e-10));
+
+    std::vector<Tcomplex> h(3);
+    CHECK_THROWS(fft(h.data(), h.size()));
+}
+#endif
+} // namespace FFT
+} // namespace Faunus
@@ -999,7 +999,7 @@ void MCSimulation::init() {
     state2.pot.key = Energy::Energybase::NEW; // this is the new energy (trial)
 
     state1.pot.init();
-    double u1 = state1.pot.energy(c);
+    double u1 = state1.pot.ledgerEnergy(c);
     uinit = u1;
 
     state2.sync(state1, c); // copy all information from state1 into state2
@@ -1025,7 +1025,7 @@ void MCSimulation::init() {
 double MCSimulation::drift() {
     Change c;
     c.all = true;
-    double ufinal = state1.pot.energy(c);
+    double ufinal = state1.pot.ledgerEnergy(c); // full recalculation that also refreshes the ledger
     double du = ufinal - uinit;
     if (std::isfinite(du)) {
         if (std::fabs(du) < 1e-10)
@@ -1067,16 +1067,65 @@ void MCSimulation::move() {
 
             if (change) {
                 lastMoveName = (**mv).name; // store name of move for output
-                double unew, uold, du;
-                //#pragma omp parallel sections
-                {
-                    //#pragma omp section
-                    { unew = state2.pot.energy(change); }
-                    //#pragma omp section
-                    { uold = state1.pot.energy(change); }
+                state2.pot.select(lastMoveName);
+                double unew, uold, du, bias = 0;
+
+                // with `delta`, the energy of the accepted state is taken from the running sum of energy
+                // changes so that biases and the NaN rules below see absolute energies. If that energy is
+                // not finite, e.g. from an overlap in the initial configuration, both energies are evaluated.
+                bool delta = state2.pot.delta_enable and std::isfinite(uinit + dusum);
+
+                // with early rejection, the Metropolis criterion is drawn before the energy evaluation
+                // as `du + bias < threshold` and the trial state stops summing at `umax`. This requires
+                // a bias independent of the energies which excludes parallel tempering (change.all).
+                bool early = state2.pot.earlyreject_enable and
+                             not(state2.pot.delta_enable or state2.pot.concurrent_enable or change.all or change.dV);
+                double threshold = pc::infty, umax = pc::infty;
+                if (early) {
+                    bias = (**mv).bias(change, 0, 0) + IdealTerm(state2.spc, state1.spc, change);
+                    threshold = -std::log(Move::Movebase::slump());
                 }
 
-                du = unew - uold;
+                if (delta) { // energy change directly
+                    uold = uinit + dusum;
+                    du = state2.pot.delta(change, state1.pot, state1.spc, state2.spc);
+                    unew = uold + du;
+                } else if (early) { // old energy first to set the limit on the new
+                    uold = state1.pot.ledgerEnergy(change);
+                    if (std::isfinite(uold + threshold - bias))
+                        umax = change.umax = uold + threshold - bias;
+                    unew = state2.pot.energy(change);
+                    change.umax = pc::infty;
+                    du = unew - uold;
+                } else {
+                    // the two states share no mutable energy data and can be evaluated
+                    // concurrently; exceptions cannot leave a parallel region and are rethrown
+                    std::exception_ptr error_new, error_old;
+#pragma omp parallel sections num_threads(2) if (state2.pot.concurrent_enable)
+                    {
+#pragma omp section
+                        {
+                            try {
+                                unew = state2.pot.energy(change);
+                            } catch (...) {
+                                error_new = std::current_exception();
+                            }
+                        }
+#pragma omp section
+                        {
+                            try {
+                                uold = state1.pot.ledgerEnergy(change);
+                            } catch (...) {
+                                error_old = std::current_exception();
+                            }
+                        }
+                    }
+                    if (error_new)
+                        std::rethrow_exception(error_new);
+                    if (error_old)
+                        std::rethrow_exception(error_old);
+                    du = unew - uold;
+                }
 
                 // if any energy returns NaN (from i.e. division by zero), the
                 // configuration will always be rejected, or if moving from NaN
@@ -1094,9 +1143,15 @@ void MCSimulation::move() {
                 else if (std::isnan(du))
                     du = 0; // accept
 
-                double bias = (**mv).bias(change, uold, unew) + IdealTerm(state2.spc, state1.spc, change);
+                bool accept;
+                if (early) // a trial energy at `umax` may be a partial sum
+                    accept = (unew < umax) and (du + bias < threshold);
+                else {
+                    bias = (**mv).bias(change, uold, unew) + IdealTerm(state2.spc, state1.spc, change);
+                    accept = metropolis(du + bias);
+                }
 
-                if (metropolis(du + bias)) { // accept move
+                if (accept) { // accept move
                     state1.sync(state2, change);
                     (**mv).accept(change);
                 } else { // reject move
@@ -1115,6 +1170,9 @@ void MCSimulation::to_json(json &j) {
     j["temperature"] = pc::temperature / 1.0_K;
     j["moves"] = moves;
     j["energy"].push_back(state1.pot);
+    auto order = state2.pot.termOrder(); // adaptive order of energy terms for each move
+    if (not order.empty())
+        j["energy order"] = order;
     j["last move"] = lastMoveName;
 }
 
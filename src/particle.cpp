@@ -72,19 +72,25 @@ const AtomData &Particle::traits() {
 }
 Particle::Particle(const AtomData &a) { *this = json(a).front(); }
 void Particle::rotate(const Eigen::Quaterniond &q, const Eigen::Matrix3d &m) {
-    if (shape != nullptr)
-        shape->rotate(q, m);
+#ifdef FAU_ANISOTROPIC
+    shape.rotate(q, m);
+#else
+    (void)q;
+    (void)m;
+#endif
 }
 void from_json(const json &j, Particle &p) {
     p.id = j.value("id", -1);
     p.pos = j.value("pos", Point(0, 0, 0));
     p.charge = j.value("q", 0.0);
-    if (p.shape != nullptr)
-        from_json(j, *p.shape);
+#ifdef FAU_ANISOTROPIC
+    from_json(j, p.shape);
+#endif
 }
 void to_json(json &j, const Particle &p) {
-    if (p.shape != nullptr)
-        to_json(j, *p.shape);
+#ifdef FAU_ANISOTROPIC
+    to_json(j, p.shape);
+#endif
     j["id"] = p.id;
     j["pos"] = p.pos;
     j["q"] = p.charge;
@@ -94,13 +94,7 @@ struct Cigar : public ParticlePropertyBase {
 }; //!< Sphero-cylinder properties
 
 /**
- * @brief Particle
- *
- * This is the Particle class used to store information about
- * particles. In addition to charge, positionn and ID, the particle
- * can store auxiliary information via the `shape` pointer. This
- * can is typically anisotropic properties which in this way
- * is stored in an alternative memory location.
+ * @brief Particle assembled from a list of properties
  * */
 template <typename... Properties> class ParticleTemplate : public Properties... {
   private:
@@ -134,20 +128,30 @@ template <typename... Properties> void from_json(const json &j, ParticleTemplate
     from_json<Properties...>(j, dynamic_cast<Properties &>(a)...);
 }
 
+/**
+ * @brief Particle
+ *
+ * This is the Particle class used to store information about
+ * particles. The layout is selected at compile time: by default only
+ * charge, position and ID are stored, which is cheap to copy in
+ * isotropic simulations. If compiled with `FAU_ANISOTROPIC`
+ * (`cmake -DENABLE_ANISOTROPIC=on`), anisotropic properties are
+ * stored inline in `shape` and accessed via `operator->`.
+ * */
 class Particle {
   public:
     int id = -1;           //!< Particle id/type
     double charge = 0;     //!< Particle charge
     Point pos = {0, 0, 0}; //!< Particle position vector
-    std::shared_ptr<ParticleTemplate<Dipole, Quadrupole, Cigar>> shape = nullptr;
+#ifdef FAU_ANISOTROPIC
+    ParticleTemplate<Dipole, Quadrupole, Cigar> shape; //!< Anisotropic properties
+    auto operator-> () { return &shape; }
+    auto operator-> () const { return &shape; }
+#endif
     const AtomData &traits();
     Particle() = default;
     Particle(const AtomData &a);
     void rotate(const Eigen::Quaterniond &q, const Eigen::Matrix3d &m);
-    auto &operator-> () {
-        assert(shape != nullptr);
-        return *shape;
-    }
 };
 
 void from_json(const json &j, Particle &p);
@@ -203,6 +207,32 @@ TEST_CASE("[Faunus] Particle") {
     CHECK(p1.Q(1, 2) == Approx(-2));
     CHECK(p1.Q(2, 2) == Approx(1));
 }
+
+TEST_CASE("[Faunus] Particle - layout") {
+    using doctest::Approx;
+    Particle p1, p2;
+    p1.id = 1;
+    p1.charge = -0.8;
+    p1.pos = {1, 2, 3};
+#ifdef FAU_ANISOTROPIC
+    p1->mu = {0, 0, 1};
+    p1->mulen = 2.8;
+    QuaternionRotate qrot(pc::pi / 2, {0, 1, 0});
+    p1.rotate(qrot.first, qrot.second);
+    CHECK(p1->mu.x() == Approx(1));
+    CHECK(p1->mu.z() == Approx(0));
+    p2 = json(p1);
+    CHECK(p2->mulen == 2.8);
+    CHECK(p2->mu.x() == Approx(1));
+#else
+    CHECK(sizeof(Particle) <= sizeof(Point) + 2 * sizeof(double)); // no storage for anisotropic properties
+    CHECK(json(p1).count("mu") == 0);
+    p2 = json(p1);
+#endif
+    CHECK(p2.id == 1);
+    CHECK(p2.charge == -0.8);
+    CHECK(p2.pos == Point(1, 2, 3));
+}
 #endif
 
 } // namespace Faunus
@@ -6,6 +6,7 @@ namespace Energy {
 Penalty::Penalty(const json &j, Tspace &spc) : spc(spc) {
     using namespace ReactionCoordinate;
     name = "penalty";
+    ledger = NOLEDGER; // energy changes as the penalty function is updated
     overwrite_penalty = j.value("overwrite", true);
     f0 = j.at("f0").get<double>();
     scale = j.at("scale").get<double>();
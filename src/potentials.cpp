@@ -33,7 +33,7 @@ Faunus::Potential::CosAttract::CosAttract(const std::string &name) { PairPotenti
 void Faunus::Potential::CoulombGalore::sfYukawa(const Faunus::json &j) {
     kappa = 1.0 / j.at("debyelength").get<double>();
     I = kappa*kappa / ( 8.0*lB*pc::pi*pc::Nav/1e27 );
-    table = sf.generate( [&](double q) { return std::exp(-q*rc*kappa) - std::exp(-kappa*rc); }, 0, 1 ); // q=r/Rc
+    table = generate( [&](double q) { return std::exp(-q*rc*kappa) - std::exp(-kappa*rc); }, 0, 1 ); // q=r/Rc
     // we could also fill in some info std::string or JSON output...
 }
 
@@ -44,7 +44,7 @@ void Faunus::Potential::CoulombGalore::sfYukawaPoisson(const Faunus::json &j) {
     D = j.value("D",3);
     if( (C < 1) || (D < 1) )
       throw std::runtime_error("`C` and `D` must be larger than zero");
-    table = sf.generate( [&](double q) {
+    table = generate( [&](double q) {
       double qt = (1.0 -exp(2.0*kappa*rc*q))/(1.0-exp(2.0*kappa*rc));
       double tmp = 0.0;
       for(int c = 0; c < C; c++)
@@ -57,7 +57,7 @@ void Faunus::Potential::CoulombGalore::sfYukawaPoisson(const Faunus::json &j) {
 
 void Faunus::Potential::CoulombGalore::sfReactionField(const Faunus::json &j) {
     epsrf = j.at("eps_rf");
-    table = sf.generate( [&](double q) { return 1 + (( epsrf - epsr ) / ( 2 * epsrf + epsr ))*q*q*q
+    table = generate( [&](double q) { return 1 + (( epsrf - epsr ) / ( 2 * epsrf + epsr ))*q*q*q
             - 3 * ( epsrf / ( 2 * epsrf + epsr ))*q ; }, 0, 1);
     calcDielectric = [&](double M2V) {
         if(epsrf > 1e10)
@@ -76,20 +76,20 @@ void Faunus::Potential::CoulombGalore::sfReactionField(const Faunus::json &j) {
 
 void Faunus::Potential::CoulombGalore::sfQpotential(const Faunus::json &j) {
     order = j.value("order",300);
-    table = sf.generate( [&](double q) { return qPochhammerSymbol( q, 1, order ); }, 0, 1 );
+    table = generate( [&](double q) { return qPochhammerSymbol( q, 1, order ); }, 0, 1 );
     calcDielectric = [&](double M2V) { return 1 + 3*M2V; };
     selfenergy_prefactor = 0.5;
 }
 
 void Faunus::Potential::CoulombGalore::sfYonezawa(const Faunus::json &j) {
     alpha = j.at("alpha");
-    table = sf.generate( [&](double q) { return 1 - std::erfc(alpha*rc)*q + q*q; }, 0, 1 );
+    table = generate( [&](double q) { return 1 - std::erfc(alpha*rc)*q + q*q; }, 0, 1 );
     calcDielectric = [&](double M2V) { return 1 + 3*M2V; };
     selfenergy_prefactor = erf(alpha*rc);
 }
 
 void Faunus::Potential::CoulombGalore::sfFanourgakis(const Faunus::json&) {
-    table = sf.generate( [&](double q) { return 1 - 1.75*q + 5.25*pow(q,5) - 7*pow(q,6) + 2.5*pow(q,7); }, 0, 1 );
+    table = generate( [&](double q) { return 1 - 1.75*q + 5.25*pow(q,5) - 7*pow(q,6) + 2.5*pow(q,7); }, 0, 1 );
     calcDielectric = [&](double M2V) { return 1 + 3*M2V; };
     selfenergy_prefactor = 0.875;
 }
@@ -99,7 +99,7 @@ void Faunus::Potential::CoulombGalore::sfPoisson(const Faunus::json &j) {
     D = j.value("D",3);
     if( (C < 1) || (D < 1) )
       throw std::runtime_error("`C` and `D` must be larger than zero");
-    table = sf.generate( [&](double q) {
+    table = generate( [&](double q) {
       double tmp = 0.0;
       for(int c = 0; c < C; c++)
           tmp += double(factorial(D -1 + c))/double(factorial(D -1))/double(factorial(c))*double(C-c)/double(C)*pow(q,double(c));
@@ -111,7 +111,7 @@ void Faunus::Potential::CoulombGalore::sfPoisson(const Faunus::json &j) {
 
 void Faunus::Potential::CoulombGalore::sfFennel(const Faunus::json &j) {
     alpha = j.at("alpha");
-    table = sf.generate( [&](double q) { return (erfc(alpha*rc*q) - std::erfc(alpha*rc)*q + (q-1.0)*q*(std::erfc(alpha*rc)
+    table = generate( [&](double q) { return (erfc(alpha*rc*q) - std::erfc(alpha*rc)*q + (q-1.0)*q*(std::erfc(alpha*rc)
                     + 2 * alpha * rc / std::sqrt(pc::pi) * std::exp(-alpha*alpha*rc*rc))); }, 0, 1 );
     calcDielectric = [&](double M2V) { double T = erf(alpha*rc) - (2 / (3 * sqrt(pc::pi)))
         * exp(-alpha*alpha*rc*rc) * (alpha*alpha*rc*rc * alpha*alpha*rc*rc + 2.0 * alpha*alpha*rc*rc + 3.0);
@@ -121,7 +121,7 @@ void Faunus::Potential::CoulombGalore::sfFennel(const Faunus::json &j) {
 
 void Faunus::Potential::CoulombGalore::sfEwald(const Faunus::json &j) {
     alpha = j.at("alpha");
-    table = sf.generate( [&](double q) { return std::erfc(alpha*rc*q); }, 0, 1 );
+    table = generate( [&](double q) { return std::erfc(alpha*rc*q); }, 0, 1 );
     calcDielectric = [&](double M2V) {
         double T = std::erf(alpha*rc) - (2 / (3 * sqrt(pc::pi)))
             * std::exp(-alpha*alpha*rc*rc) * ( 2*alpha*alpha*rc*rc + 3);
@@ -132,7 +132,7 @@ void Faunus::Potential::CoulombGalore::sfEwald(const Faunus::json &j) {
 
 void Faunus::Potential::CoulombGalore::sfWolf(const Faunus::json &j) {
     alpha = j.at("alpha");
-    table = sf.generate( [&](double q) { return (erfc(alpha*rc*q) - erfc(alpha*rc)*q); }, 0, 1 );
+    table = generate( [&](double q) { return (erfc(alpha*rc*q) - erfc(alpha*rc)*q); }, 0, 1 );
     calcDielectric = [&](double M2V) { double T = erf(alpha*rc) - (2 / (3 * sqrt(pc::pi))) * exp(-alpha*alpha*rc*rc)
         * ( 2.0 * alpha*alpha*rc*rc + 3.0);
         return (((T + 2.0) * M2V + 1.0)/ ((T - 1.0) * M2V + 1.0));};
@@ -140,7 +140,7 @@ void Faunus::Potential::CoulombGalore::sfWolf(const Faunus::json &j) {
 }
 
 void Faunus::Potential::CoulombGalore::sfPlain(const Faunus::json&, double val) {
-    table = sf.generate( [&](double) { return val; }, 0, 1 );
+    table = generate( [&](double) { return val; }, 0, 1 );
     calcDielectric = [&](double M2V) { return (2.0*M2V + 1.0)/(1.0 - M2V); };
     selfenergy_prefactor = 0.0;
 }
@@ -160,6 +160,12 @@ void Faunus::Potential::CoulombGalore::from_json(const Faunus::json &j) {
         depsdt = j.value("depsdt", -0.368*pc::temperature/epsr);
         sf.setTolerance(
                 j.value("utol",1e-5),j.value("ftol",1e-2) );
+        gsf.setTolerance(
+                j.value("utol",1e-5),j.value("ftol",1e-2) );
+        auto tabulator = j.value("tabulator", std::string("andrea"));
+        if (tabulator != "andrea" and tabulator != "grid")
+            throw std::runtime_error("tabulator must be `andrea` or `grid`");
+        grid = (tabulator == "grid");
 
         if (type=="yukawapoisson") sfYukawaPoisson(j);
         if (type=="reactionfield") sfReactionField(j);
@@ -170,7 +176,7 @@ void Faunus::Potential::CoulombGalore::from_json(const Faunus::json &j) {
         if (type=="yukawa") sfYukawa(j);
         if (type=="fennel") sfFennel(j);
         if (type=="plain") sfPlain(j,1);
-        if (type=="ewald") sfEwald(j);
+        if (type=="ewald" or type=="pme") sfEwald(j);
         if (type=="none") sfPlain(j,0);
         if (type=="wolf") sfWolf(j);
 
@@ -209,6 +215,8 @@ void Faunus::Potential::CoulombGalore::to_json(Faunus::json &j) const {
     j["lB"] = lB;
     j["cutoff"] = rc;
     j["type"] = type;
+    if (grid)
+        j["tabulator"] = "grid";
     if (type=="yukawa" || type=="yukawapoisson") {
         j["debyelength"] = 1.0/kappa;
         j["ionic strength"] = I;
@@ -219,7 +227,7 @@ void Faunus::Potential::CoulombGalore::to_json(Faunus::json &j) const {
     }
     if (type=="qpotential")
         j["order"] = order;
-    if (type=="yonezawa" || type=="fennel" || type=="wolf" || type=="ewald")
+    if (type=="yonezawa" || type=="fennel" || type=="wolf" || type=="ewald" || type=="pme")
         j["alpha"] = alpha;
     if (type=="reactionfield") {
         if(epsrf > 1e10)
@@ -23,6 +23,26 @@ namespace Faunus {
         void to_json(json &j, const PairPotentialBase &base); //!< Serialize any pair potential to json
         void from_json(const json &j, PairPotentialBase &base); //!< Serialize any pair potential from json
 
+        /**
+         * @brief Detects if a pair potential has a batch kernel
+         *
+         * Batch kernels evaluate the summed energy of one particle, `a`, with a contiguous
+         * block of `n` partners given by squared distances, charges, and atom ids:
+         *
+         * ~~~ cpp
+         *     double batch(const Particle &a, const double *r2, const double *charge, const int *id, int n) const;
+         * ~~~
+         *
+         * Loops are written so that they can be vectorised, see `ENABLE_SIMD` in CMake.
+         */
+        template <class T, class = void> struct has_batch : std::false_type {};
+
+        template <class T>
+        struct has_batch<T, decltype(void(std::declval<const T &>().batch(
+                                std::declval<const Particle &>(), std::declval<const double *>(),
+                                std::declval<const double *>(), std::declval<const int *>(), 0)))>
+            : std::true_type {};
+
         /**
          * @brief Statically combines two pair potentials at compile-time
          *
@@ -46,6 +66,13 @@ namespace Faunus {
                     return first.force(a, b, r2, p) + second.force(a, b, r2, p);
                 } //!< Combine force
 
+                template <class Tparticle, class U1 = T1, class U2 = T2>
+                inline auto batch(const Tparticle &a, const double *r2, const double *charge, const int *id,
+                                  int n) const -> decltype(std::declval<const U1 &>().batch(a, r2, charge, id, n) +
+                                                           std::declval<const U2 &>().batch(a, r2, charge, id, n)) {
+                    return first.batch(a, r2, charge, id, n) + second.batch(a, r2, charge, id, n);
+                } //!< Combine batch energies; available only if both potentials have batch kernels
+
                 void from_json(const json &j) override {
                     first = j;
                     second = j;
@@ -272,6 +299,18 @@ namespace Faunus {
                         return m->eps(a.id, b.id) * (x * x - x);
                     }
 
+                    double batch(const Tparticle &a, const double *r2, const double *, const int *id, int n) const {
+                        const double *s2 = m->s2.row(a.id), *eps = m->eps.row(a.id);
+                        double u = 0;
+#pragma omp simd reduction(+ : u)
+                        for (int k = 0; k < n; k++) {
+                            double x = s2[id[k]] / r2[k]; // s2/r2
+                            x = x * x * x;                // s6/r6
+                            u += eps[id[k]] * (x * x - x);
+                        }
+                        return u;
+                    } //!< Energy of `a` with `n` partners; see `has_batch`
+
                     void to_json(json &j) const override { j = *m; }
 
                     void from_json(const json &j) override { 
@@ -319,6 +358,18 @@ namespace Faunus {
                         return operator()(a, b, r.squaredNorm());
                     }
 
+                    double batch(const Particle &a, const double *r2, const double *, const int *id, int n) const {
+                        const double *s2 = m->s2.row(a.id), *eps = m->eps.row(a.id);
+                        double u = 0;
+#pragma omp simd reduction(+ : u)
+                        for (int k = 0; k < n; k++) {
+                            double x = s2[id[k]] / r2[k]; // (s/r)^2
+                            x = x * x * x;                // (s/r)^6
+                            u += (r2[k] > s2[id[k]] * twototwosixth) ? 0 : eps[id[k]] * (x * x - x + onefourth);
+                        }
+                        return u;
+                    } //!< Energy of `a` with `n` partners; see `has_batch`
+
                     Point force(const Particle &a, const Particle &b, double r2, const Point &p) const {
                         double x = m->s2(a.id, b.id); // s^2
                         if (r2 > x * twototwosixth)
@@ -474,6 +525,20 @@ namespace Faunus {
                     }
             }; //!< SquareWell potential
 
+        /**
+         * @brief Detects if a pair potential never returns negative energies
+         *
+         * For such potentials, a partial sum over pairs is a lower bound for the full
+         * sum which allows energy evaluations to stop early; see `Change::umax`.
+         */
+        template <class T> struct is_repulsive : std::false_type {};
+        template <class T> struct is_repulsive<HardSphere<T>> : std::true_type {};
+        template <class T> struct is_repulsive<WeeksChandlerAndersen<T>> : std::true_type {};
+        template <class T> struct is_repulsive<Hertz<T>> : std::true_type {};
+        template <class T1, class T2>
+        struct is_repulsive<CombinedPairPotential<T1, T2>>
+            : std::integral_constant<bool, is_repulsive<T1>::value and is_repulsive<T2>::value> {};
+
         /**
          * @brief Cosine attraction
          * @details This is an attractive potential used for coarse grained lipids
@@ -627,6 +692,8 @@ namespace Faunus {
         class CoulombGalore : public PairPotentialBase {
             std::shared_ptr<PairMatrix<double>> ecs; // effective charge-scaling
             Tabulate::Andrea<double> sf; // splitting function
+            Tabulate::Grid<double> gsf; // splitting function w. constant time lookup
+            bool grid = false; // use lookup grid instead of binary search?
             Tabulate::TabulatorBase<double>::data table; // data for splitting function
             std::function<double(double)> calcDielectric; // function for dielectric const. calc.
             std::string type;
@@ -647,6 +714,14 @@ namespace Faunus {
             void sfWolf(const json &j);
             void sfPlain(const json &j, double val=1);
 
+            Tabulate::TabulatorBase<double>::data generate(std::function<double(double)> f, double min, double max) {
+                return grid ? gsf.generate(f, min, max) : sf.generate(f, min, max);
+            } //!< Tabulate splitting function
+
+            inline double splitting(double q) const {
+                return grid ? gsf.eval(table, q) : sf.eval(table, q);
+            } //!< Splitting function at q=r/rc
+
             public:
             CoulombGalore(const std::string &name="coulomb");
 
@@ -656,7 +731,7 @@ namespace Faunus {
                 double operator()(const Tparticle &a, const Tparticle &b, double r2) const {
                     if (r2 < rc2) {
                         double r = std::sqrt(r2);
-                        return lB * ecs->operator()(a.id,b.id) * a.charge * b.charge / r * sf.eval( table, r*rc1i );
+                        return lB * ecs->operator()(a.id,b.id) * a.charge * b.charge / r * splitting( r*rc1i );
                     }
                     return 0;
                 }
@@ -666,11 +741,37 @@ namespace Faunus {
                     return operator()(a,b,r.squaredNorm());
                 }
 
+                template <typename Tparticle>
+                double batch(const Tparticle &a, const double *r2, const double *charge, const int *id, int n) const {
+                    constexpr int blocksize = 64;
+                    alignas(64) double r[blocksize], s[blocksize];
+                    const double *e = ecs->row(a.id);
+                    double u = 0;
+                    for (int first = 0; first < n; first += blocksize) {
+                        int m = std::min(blocksize, n - first);
+                        const double *_r2 = r2 + first, *_charge = charge + first;
+                        const int *_id = id + first;
+#pragma omp simd
+                        for (int k = 0; k < m; k++) {
+                            r[k] = std::sqrt(_r2[k]);
+                            s[k] = std::min(r[k] * rc1i, 1.0); // stay within table; masked below
+                        }
+                        if (grid)
+                            gsf.eval(table, s, s, m);
+                        else
+                            sf.eval(table, s, s, m);
+#pragma omp simd reduction(+ : u)
+                        for (int k = 0; k < m; k++)
+                            u += (_r2[k] < rc2) ? e[_id[k]] * _charge[k] / r[k] * s[k] : 0;
+                    }
+                    return lB * a.charge * u;
+                } //!< Energy of `a` with `n` partners; see `has_batch`
+
                 template <typename Tparticle>
                 Point force(const Tparticle &a, const Tparticle &b, double r2, const Point &p) const {
                     if (r2 < rc2) {
                         double r = sqrt(r2);
-                        return lB * a.charge * b.charge * ( -sf.eval( table, r*rc1i )/r2 + sf.evalDer( table, r*rc1i )/r )*p;
+                        return lB * a.charge * b.charge * ( -splitting( r*rc1i )/r2 + sf.evalDer( table, r*rc1i )/r )*p;
                     }
                     return Point(0,0,0);
                 }
@@ -757,7 +858,6 @@ namespace Faunus {
          */
         template<class T /** particle type */>
             class FunctorPotential : public PairPotentialBase {
-                typedef std::function<double(const T&, const T&, const Point&)> uFunc;
                 json _j; // storage for input json
                 typedef CombinedPairPotential<Coulomb,HardSphere<T>> PrimitiveModel;
                 typedef CombinedPairPotential<Coulomb,WeeksChandlerAndersen<T>> PrimitiveModelWCA;
@@ -779,47 +879,108 @@ namespace Faunus {
                     PrimitiveModel,    // 8
                     PrimitiveModelWCA, // 9
                     Hertz<T>,          // 10
-		    SquareWell<T>      // 11
+		    SquareWell<T>,     // 11
+                    CustomPairPotential // 12
                         > potlist;
 
-                uFunc combineFunc(const json &j) { 
-                    uFunc u = [](const T&, const T&, const Point&){return 0.0;};
+                /*
+                 * Sum of pair-potentials compiled into a flat list of type-tagged
+                 * terms. Each term is dispatched through a switch on its type so that
+                 * the potential bodies can be inlined, avoiding indirect calls.
+                 * Instances are stored by type in the same order as in `potlist`.
+                 */
+                class Combination {
+                    struct Term {
+                        int type;  // index in `potlist`
+                        int index; // index in vector of instances of that type
+                    };
+                    std::vector<Term> terms;
+                    std::tuple<
+                        std::vector<CoulombGalore>,
+                        std::vector<CosAttract>,
+                        std::vector<Polarizability<T>>,
+                        std::vector<HardSphere<T>>,
+                        std::vector<LennardJones<T>>,
+                        std::vector<RepulsionR3>,
+                        std::vector<SASApotential>,
+                        std::vector<WeeksChandlerAndersen<T>>,
+                        std::vector<PrimitiveModel>,
+                        std::vector<PrimitiveModelWCA>,
+                        std::vector<Hertz<T>>,
+                        std::vector<SquareWell<T>>,
+                        std::vector<CustomPairPotential>> instances;
+
+                    template<size_t I>
+                        inline double eval(int index, const T &a, const T &b, const Point &r) const {
+                            return std::get<I>(instances)[index](a, b, r);
+                        }
+
+                    public:
+                    template<size_t I, class Tpot> void add(const Tpot &pot) {
+                        auto &v = std::get<I>(instances);
+                        v.push_back(pot);
+                        terms.push_back({int(I), int(v.size()) - 1});
+                    } //!< Append potential of type `I` in `potlist`
+
+                    size_t size() const { return terms.size(); }
+
+                    inline double operator()(const T &a, const T &b, const Point &r) const {
+                        double u = 0;
+                        for (auto &t : terms)
+                            switch (t.type) {
+                                case 0: u += eval<0>(t.index, a, b, r); break;
+                                case 1: u += eval<1>(t.index, a, b, r); break;
+                                case 2: u += eval<2>(t.index, a, b, r); break;
+                                case 3: u += eval<3>(t.index, a, b, r); break;
+                                case 4: u += eval<4>(t.index, a, b, r); break;
+                                case 5: u += eval<5>(t.index, a, b, r); break;
+                                case 6: u += eval<6>(t.index, a, b, r); break;
+                                case 7: u += eval<7>(t.index, a, b, r); break;
+                                case 8: u += eval<8>(t.index, a, b, r); break;
+                                case 9: u += eval<9>(t.index, a, b, r); break;
+                                case 10: u += eval<10>(t.index, a, b, r); break;
+                                case 11: u += eval<11>(t.index, a, b, r); break;
+                                case 12: u += eval<12>(t.index, a, b, r); break;
+                            }
+                        return u;
+                    }
+                };
+
+                Combination combine(const json &j) {
+                    Combination u;
                     if (j.is_array()) {
                         for (auto &i : j) // loop over all defined potentials in array
                             if (i.is_object() and (i.size()==1))
                                 for (auto it : i.items()) {
-                                    uFunc _u = nullptr;
+                                    size_t n = u.size();
                                     try {
-                                        if (it.key()=="custom") _u = CustomPairPotential() = it.value();
-                                        else if (it.key()=="coulomb") _u = std::get<0>(potlist) = i;
-                                        else if (it.key()=="cos2") _u = std::get<1>(potlist) = i;
-                                        else if (it.key()=="polar") _u = std::get<2>(potlist) = i;
-                                        else if (it.key()=="hardsphere") _u = std::get<3>(potlist) = i;
-                                        else if (it.key()=="lennardjones") _u = std::get<4>(potlist) = i;
-                                        else if (it.key()=="repulsionr3") _u = std::get<5>(potlist) = i;
-                                        else if (it.key()=="sasa") _u = std::get<6>(potlist) = i;
-                                        else if (it.key()=="wca") _u = std::get<7>(potlist) = i;
-                                        else if (it.key()=="pm") _u = std::get<8>(potlist) = it.value();
-                                        else if (it.key()=="pmwca") _u = std::get<9>(potlist) = it.value();
-                                        else if (it.key()=="hertz") _u = std::get<10>(potlist) = it.value();
-                                        else if (it.key()=="squarewell") _u = std::get<11>(potlist) = it.value();
-                                        // place additional potentials here...
+                                        if (it.key()=="custom") u.add<12>(std::get<12>(potlist) = it.value());
+                                        else if (it.key()=="coulomb") u.add<0>(std::get<0>(potlist) = i);
+                                        else if (it.key()=="cos2") u.add<1>(std::get<1>(potlist) = i);
+                                        else if (it.key()=="polar") u.add<2>(std::get<2>(potlist) = i);
+                                        else if (it.key()=="hardsphere") u.add<3>(std::get<3>(potlist) = i);
+                                        else if (it.key()=="lennardjones") u.add<4>(std::get<4>(potlist) = i);
+                                        else if (it.key()=="repulsionr3") u.add<5>(std::get<5>(potlist) = i);
+                                        else if (it.key()=="sasa") u.add<6>(std::get<6>(potlist) = i);
+                                        else if (it.key()=="wca") u.add<7>(std::get<7>(potlist) = i);
+                                        else if (it.key()=="pm") u.add<8>(std::get<8>(potlist) = it.value());
+                                        else if (it.key()=="pmwca") u.add<9>(std::get<9>(potlist) = it.value());
+                                        else if (it.key()=="hertz") u.add<10>(std::get<10>(potlist) = it.value());
+                                        else if (it.key()=="squarewell") u.add<11>(std::get<11>(potlist) = it.value());
+                                        // place additional potentials here and in `Combination`...
                                     } catch (std::exception &e) {
                                         throw std::runtime_error("Error adding energy '" + it.key() + "': " + e.what() + usageTip[it.key()]);
                                     }
-
-                                    if (_u!=nullptr) // if found, sum them into new function object
-                                        u = [u,_u](const T&a, const T&b, const Point &r){return u(a,b,r)+_u(a,b,r);};
-                                    else
+                                    if (u.size() == n)
                                         throw std::runtime_error("unknown pair-potential: " + it.key());
                                 }
                     } else
                         throw std::runtime_error("dictionary of potentials required");
                     return u;
-                } // parse json array of potentials to a single potential function object
+                } // parse json array of potentials to a single, compiled potential
 
                 protected:
-                PairMatrix<uFunc,true> umatrix; // matrix with potential for each atom pair
+                PairMatrix<Combination,true> umatrix; // matrix with potential for each atom pair
 
                 public:
 
@@ -835,12 +996,12 @@ namespace Faunus {
 
                 void from_json(const json &j) override {
                     _j = j;
-                    umatrix = decltype(umatrix)( atoms.size(), combineFunc(j.at("default")) );
+                    umatrix = decltype(umatrix)( atoms.size(), combine(j.at("default")) );
                     for (auto it=j.begin(); it!=j.end(); ++it) {
                         auto atompair = words2vec<std::string>(it.key()); // is this for a pair of atoms?
                         if (atompair.size()==2) {
                             auto ids = names2ids(atoms, atompair);
-                            umatrix.set(ids[0], ids[1], combineFunc(it.value()));
+                            umatrix.set(ids[0], ids[1], combine(it.value()));
                         }
                     }
                 }
@@ -866,6 +1027,8 @@ namespace Faunus {
                 };
                 PairMatrix<Ttable,true> tmatrix; // matrix with tabulated potential for each atom pair
                 Tabulate::Andrea<double> tblt; // spline class
+                Tabulate::Grid<double> gtblt; // spline class w. constant time lookup
+                bool grid = false; // use lookup grid instead of binary search?
                 bool hardsphere = false; // use hardsphere for r<rmin?
 
                 public:
@@ -885,12 +1048,17 @@ namespace Faunus {
                         else
                             return pc::infty; // assume extreme repulsion
                     }
-                    return tblt.eval(knots, r2); // we are in splined interval
+                    return grid ? gtblt.eval(knots, r2) : tblt.eval(knots, r2); // we are in splined interval
                 }
 
                 void from_json(const json &j) override {
                     FunctorPotential<T>::from_json(j);
                     tblt.setTolerance(j.value("utol",1e-5),j.value("ftol",1e-2) );
+                    gtblt.setTolerance(j.value("utol",1e-5),j.value("ftol",1e-2) );
+                    auto tabulator = j.value("tabulator", std::string("andrea"));
+                    if (tabulator != "andrea" and tabulator != "grid")
+                        throw std::runtime_error("tabulator must be `andrea` or `grid`");
+                    grid = (tabulator == "grid");
                     double u_at_rmin = j.value("u_at_rmin",20);
                     double u_at_rmax = j.value("u_at_rmax",1e-6);
                     hardsphere = j.value("hardsphere",false);
@@ -940,7 +1108,8 @@ namespace Faunus {
 
                                 assert( rmin2 < rmax2 );
 
-                                Ttable knotdata = tblt.generate( [&](double r2) { return this->umatrix(i,k)(a, b, {0,0,sqrt(r2)}); }, rmin2, rmax2);
+                                auto f = [&](double r2) { return this->umatrix(i,k)(a, b, {0,0,sqrt(r2)}); };
+                                Ttable knotdata = grid ? gtblt.generate(f, rmin2, rmax2) : tblt.generate(f, rmin2, rmax2);
 
                                 // assert if potential is negative for r<rmin
                                 if (tblt.eval(knotdata, knotdata.rmin2+dr) < 0)
@@ -1000,6 +1169,7 @@ namespace Faunus {
             CHECK( u(a,b,r) == Approx( coulomb(a,b,r) + wca(a,b,r) ) );
             CHECK( u(c,c,r*1.01) == 0 );
             CHECK( u(c,c,r*0.99) == pc::infty );
+            CHECK_THROWS( u = R"({"default": [{"nonexisting": {}}]})"_json );
         }
 #endif
 
@@ -1292,6 +1462,35 @@ namespace Faunus {
                 CHECK( pot(a,b,{10,0,0}) == Approx( f * 4*pc::pi*(2.1*2.1+1.5*1.5) ) ); // far apart
                 CHECK( pot(a,b,{2.5,0,0})== Approx( f * 71.74894965974514 ) ); // partial overlap
             }
+
+            SUBCASE("batch kernels") {
+                atoms = R"([{"A": {"sigma": 2.0, "eps": 0.2, "q": 1.0}},
+                            {"B": {"sigma": 4.0, "eps": 0.1, "q": -1.0}}])"_json.get<decltype(atoms)>();
+                json in = R"({"coulomb": {"type": "qpotential", "epsr": 80, "cutoff": 12, "order": 3},
+                              "lennardjones": {"mixing": "LB"}, "wca": {"mixing": "LB"}})"_json;
+                CombinedPairPotential<CoulombGalore, LennardJones<Particle>> coulomblj = in;
+                CombinedPairPotential<CoulombGalore, WeeksChandlerAndersen<Particle>> coulombwca = in;
+                CHECK( has_batch<decltype(coulomblj)>::value );
+                CHECK( has_batch<decltype(coulombwca)>::value );
+                CHECK( not has_batch<SASApotential>::value );
+
+                a.charge = 1.0;
+                std::vector<double> r2, charge;
+                std::vector<int> id;
+                double ulj = 0, uwca = 0;
+                for (double r = 1.5; r < 14; r += 0.25) { // beyond the coulomb cutoff, too
+                    b.id = int(r2.size()) % 2;
+                    b.charge = (b.id == 0) ? 1.0 : -1.0;
+                    r2.push_back(r * r);
+                    charge.push_back(b.charge);
+                    id.push_back(b.id);
+                    ulj += coulomblj(a, b, {0, 0, r});
+                    uwca += coulombwca(a, b, {0, 0, r});
+                }
+                int n = int(r2.size());
+                CHECK( coulomblj.batch(a, r2.data(), charge.data(), id.data(), n) == Approx(ulj) );
+                CHECK( coulombwca.batch(a, r2.data(), charge.data(), id.data(), n) == Approx(uwca) );
+            }
         }
 #endif
 
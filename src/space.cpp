@@ -9,6 +9,7 @@ void Change::clear() {
     all = false;
     dN = false;
     moved2moved = true;
+    umax = pc::infty;
     groups.clear();
     assert(empty());
 }
@@ -25,6 +26,7 @@ Change::operator bool() const { return not empty(); }
 void Space::clear() {
     p.clear();
     groups.clear();
+    arrays.assign(p);
 }
 
 void Space::push_back(int molid, const Space::Tpvec &in) {
@@ -88,6 +90,24 @@ void Space::sync(Space &other, const Change &change) {
     }
     assert(p.size() == other.p.size());
     assert(p.begin() != other.p.begin());
+    if (arrays_enable)
+        updateArrays(change);
+}
+
+void Space::updateArrays(const Change &change) {
+    if (change.all or change.dV or arrays.size() != p.size())
+        arrays.assign(p);
+    else
+        for (auto &d : change.groups) {
+            auto &g = groups.at(d.index);
+            size_t offset = std::distance(p.begin(), g.begin());
+            if (d.all or d.dNatomic) // all particles, including inactive; atomic deletions may swap unlisted atoms
+                for (size_t i = offset; i < offset + g.capacity(); i++)
+                    arrays.set(i, p[i]);
+            else
+                for (int i : d.atoms)
+                    arrays.set(offset + i, p[offset + i]);
+        }
 }
 
 void Space::scaleVolume(double Vnew, Geometry::VolumeMethod method) {
@@ -134,6 +154,9 @@ void Space::scaleVolume(double Vnew, Geometry::VolumeMethod method) {
     if (method == Geometry::ISOCHORIC)
         Vold = std::pow(Vold, 1. / 3.);
 
+    if (arrays_enable)
+        arrays.assign(p); // all positions have moved
+
     for (auto f : scaleVolumeTriggers)
         f(*this, Vold, Vnew);
 }
@@ -24,6 +24,7 @@ struct Change {
     bool dN = false;         //!< True if the number of atomic or molecular species has changed
     bool moved2moved = true; //!< If several groups are moved, should they interact with each other?
     bool chargeMove = false; 
+    double umax = pc::infty; //!< Trial energy at or above which the move is rejected; terms may stop summing here
 
     struct data {
         bool dNatomic = false;  //!< True if the number of atomic molecules has changed
@@ -57,6 +58,36 @@ TEST_CASE("[Faunus] Change") {
 }
 #endif
 
+/**
+ * @brief Structure-of-arrays copy of particle positions, charges, and ids
+ *
+ * Contiguous arrays that allow pair loops to be vectorised. The arrays
+ * mirror `Space::p` and are refreshed using `Change` objects, see
+ * `Space::updateArrays()`.
+ */
+struct ParticleArrays {
+    std::vector<double> x, y, z, charge;
+    std::vector<int> id;
+
+    inline size_t size() const { return id.size(); }
+
+    inline void set(size_t i, const Particle &a) {
+        x[i] = a.pos.x();
+        y[i] = a.pos.y();
+        z[i] = a.pos.z();
+        charge[i] = a.charge;
+        id[i] = a.id;
+    } //!< Copy particle data to index `i`
+
+    template <class Tparticle_vector> void assign(const Tparticle_vector &p) {
+        for (auto v : {&x, &y, &z, &charge})
+            v->resize(p.size());
+        id.resize(p.size());
+        for (size_t i = 0; i < p.size(); i++)
+            set(i, p[i]);
+    } //!< Copy all particles
+};
+
 /**
  * @brief Placeholder for atoms and molecules
  * @tparam Tparticletype Particle type for the space
@@ -85,6 +116,8 @@ struct Space {
     Tpvec p;       //!< Particle vector
     Tgvec groups;  //!< Group vector
     Tgeometry geo; //!< Container geometry // TODO as a dependency injection in the constructor
+    ParticleArrays arrays; //!< Structure-of-arrays mirror of `p`; see `updateArrays()`
+    bool arrays_enable = false; //!< Keep `arrays` in sync with `p`? Set by energy terms that use them
 
     auto positions() const {
         return ranges::view::transform(p, [](auto &i) -> const Point & { return i.pos; });
@@ -153,6 +186,13 @@ struct Space {
 
     void sync(Space &other, const Tchange &change); //!< Copy differing data from other (o) Space using Change object
 
+    /*
+     * Only particles touched by the change are copied, except if
+     * everything or the volume has changed, or if the number of particles
+     * differs, in which case all particles are copied.
+     */
+    void updateArrays(const Tchange &change); //!< Refresh structure-of-arrays mirror from `p` using Change object
+
     /*
      * Scales:
      * - positions of free atoms
@@ -220,6 +260,7 @@ using Tspace = Space;
 TEST_CASE("[Faunus] Space") {
     Tspace spc1;
     spc1.geo = R"( {"type": "sphere", "radius": 1e9} )"_json;
+    spc1.arrays_enable = true;
 
     // check molecule insertion
     atoms.resize(2);
@@ -267,6 +308,42 @@ TEST_CASE("[Faunus] Space") {
     spc1.sync(spc2, c);
     CHECK(spc1.p.back().pos.z() == doctest::Approx(-0.1));
 
+    // structure-of-arrays copy follows the synced particles
+    CHECK(spc1.arrays.size() == 2);
+    CHECK(spc1.arrays.z.back() == doctest::Approx(-0.1));
+    CHECK(spc1.arrays.x.front() == doctest::Approx(2));
+    spc1.p.front().charge = 0.5;
+    c.groups[0].all = false;
+    c.groups[0].atoms = {0};
+    spc1.updateArrays(c);
+    CHECK(spc1.arrays.charge.front() == doctest::Approx(0.5));
+
+    // atomic deletion as in speciation: a random atom is swapped with the last
+    // active atom, but only the deactivated slot is listed in the change
+    auto &g = spc1.groups.front();
+    std::iter_swap(g.begin(), g.end() - 1);
+    g.deactivate(g.end() - 1, g.end());
+    c.groups[0].atoms = {1};
+    c.groups[0].dNatomic = true;
+    spc1.updateArrays(c);
+    for (size_t i = 0; i < spc1.p.size(); i++) {
+        CHECK(spc1.arrays.x[i] == doctest::Approx(spc1.p[i].pos.x()));
+        CHECK(spc1.arrays.z[i] == doctest::Approx(spc1.p[i].pos.z()));
+        CHECK(spc1.arrays.charge[i] == doctest::Approx(spc1.p[i].charge));
+    }
+    g.activate(g.end(), g.end() + 1);
+
+    // volume scaling, forth and back as in virtual volume moves, moves all particles
+    double V = spc1.geo.getVolume();
+    for (double Vnew : {2 * V, V}) {
+        spc1.scaleVolume(Vnew);
+        for (size_t i = 0; i < spc1.p.size(); i++) {
+            CHECK(spc1.arrays.x[i] == doctest::Approx(spc1.p[i].pos.x()));
+            CHECK(spc1.arrays.y[i] == doctest::Approx(spc1.p[i].pos.y()));
+            CHECK(spc1.arrays.z[i] == doctest::Approx(spc1.p[i].pos.z()));
+        }
+    }
+
     SUBCASE("getActiveParticles") {
         // add three groups to space
         Tspace spc;
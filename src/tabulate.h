@@ -70,6 +70,8 @@ namespace Faunus
                         std::vector<T> r2;  // r2 for intervals
                         std::vector<T> c;   // c for coefficents
                         T rmin2=0, rmax2=0;     // useful to save these with table
+                        T invdx=0; // inverse spacing of lookup grid (`Grid` only)
+                        std::vector<int> index; // interval at each lookup grid point (`Grid` only)
                         bool empty() const { return r2.empty() && c.empty(); }
                     };
 
@@ -203,6 +205,40 @@ namespace Faunus
                                             dz * (d.c[pos6 + 5])))));
                 }
 
+                /**
+                 * @brief Get tabulated values for an array of x values
+                 * @param d Table data
+                 * @param x Array of x values
+                 * @param y Output array of tabulated values; may be the same as `x`
+                 * @param n Number of values
+                 *
+                 * Same result as `eval()`, but using a branch-free binary search
+                 * so that the loop over values can be vectorised.
+                 */
+                inline void eval( const typename base::data &d, const T *x, T *y, int n ) const
+                {
+                    const T *knots = d.r2.data();
+                    const T *c = d.c.data();
+                    const size_t size = d.r2.size();
+#pragma omp simd
+                    for (int k = 0; k < n; k++) {
+                        size_t low = 0, len = size;
+                        while (len > 1) {
+                            size_t half = len / 2;
+                            low = (knots[low + half] < x[k]) ? low + half : low;
+                            len -= half;
+                        }
+                        size_t pos6 = 6 * (low + (knots[low] < x[k]) - 1);
+                        T dz = x[k] - knots[pos6 / 6];
+                        y[k] = c[pos6] +
+                            dz * (c[pos6 + 1] +
+                                    dz * (c[pos6 + 2] +
+                                        dz * (c[pos6 + 3] +
+                                            dz * (c[pos6 + 4] +
+                                                dz * (c[pos6 + 5])))));
+                    }
+                }
+
                 /**
                  * @brief Get tabulated value at df(x)/dx
                  * @param d Table data
@@ -316,6 +352,87 @@ namespace Faunus
                 }
         };
 
+        /**
+         * @brief Andrea table with constant time lookup
+         *
+         * Knots and splines are generated by `Andrea` and thus satisfy the
+         * tolerances `utol` and `ftol`. A lookup grid with uniform spacing in
+         * x, no wider than the narrowest interval (within `maxbins`), stores
+         * the interval at each grid point so that the interval for any x is found
+         * from a single multiplication and truncation, instead of by a binary search.
+         * Evaluated values are identical to `Andrea::eval()`.
+         */
+        template<typename T=double>
+            class Grid : public TabulatorBase<T>
+        {
+            private:
+                typedef TabulatorBase<T> base;// for convenience
+                int maxbins=1<<14; // Max number of lookup grid points
+
+            public:
+                /**
+                 * @brief Get tabulated value at f(x)
+                 * @param d Table data
+                 * @param x x value
+                 */
+                inline T eval( const typename base::data &d, T x ) const
+                {
+                    int last = int(d.r2.size()) - 2; // last interval
+                    int bin = std::max(0, std::min(int((x - d.r2[0]) * d.invdx), int(d.index.size()) - 1));
+                    int pos = d.index[bin];
+                    while (pos > 0 and not (d.r2[pos] < x)) // guard against round-off in `bin`
+                        pos--;
+                    while (pos < last and d.r2[pos + 1] < x) // if more than one knot per bin
+                        pos++;
+                    int pos6 = 6 * pos;
+                    T dz = x - d.r2[pos];
+                    return d.c[pos6] +
+                        dz * (d.c[pos6 + 1] +
+                                dz * (d.c[pos6 + 2] +
+                                    dz * (d.c[pos6 + 3] +
+                                        dz * (d.c[pos6 + 4] +
+                                            dz * (d.c[pos6 + 5])))));
+                }
+
+                /**
+                 * @brief Get tabulated values for an array of x values
+                 *
+                 * Output array, `y`, may be the same as the input array, `x`.
+                 */
+                inline void eval( const typename base::data &d, const T *x, T *y, int n ) const
+                {
+                    for (int k = 0; k < n; k++)
+                        y[k] = eval(d, x[k]);
+                }
+
+                /**
+                 * @brief Tabulate f(x) in interval ]min,max]
+                 */
+                typename base::data generate( std::function<T( T )> f, double xmin, double xmax )
+                {
+                    Andrea<T> spline;
+                    spline.setTolerance(base::utol, base::ftol, base::umaxtol, base::fmaxtol);
+                    spline.setNumdr(base::numdr);
+                    auto d = spline.generate(f, xmin, xmax);
+
+                    T width = d.r2.back() - d.r2.front(); // narrowest interval
+                    for (size_t i = 1; i < d.r2.size(); i++)
+                        width = std::min(width, d.r2[i] - d.r2[i - 1]);
+                    int nbins = std::max(1, std::min(maxbins, int(std::ceil((d.r2.back() - d.r2.front()) / width))));
+                    T dx = (d.r2.back() - d.r2.front()) / nbins;
+                    d.invdx = 1 / dx; // grid origin is the first knot
+                    d.index.resize(nbins + 1);
+                    int pos = 0, last = int(d.r2.size()) - 2;
+                    for (int bin = 0; bin <= nbins; bin++) { // last interval with knot below grid point
+                        T x = d.r2.front() + bin * dx;
+                        while (pos < last and d.r2[pos + 1] < x)
+                            pos++;
+                        d.index[bin] = pos;
+                    }
+                    return d;
+                }
+        };
+
 #ifdef DOCTEST_LIBRARY_INCLUDED
         TEST_CASE("[Faunus] Andrea")
         {
@@ -330,6 +447,35 @@ namespace Faunus
             CHECK( spline.eval(d,5) == Approx(f(5)) );
             CHECK( spline.eval(d,10) == Approx(f(10)) );
             CHECK( spline.eval(d,10+1e-9) != Approx(10+1e-9));
+
+            // array version must give the same values
+            std::vector<double> x = {1e-9, 0.1, 2.5, 5, 7.77, 9.999, 10}, y(x.size());
+            spline.eval(d, x.data(), y.data(), int(x.size()));
+            for (size_t i = 0; i < x.size(); i++)
+                CHECK( y[i] == spline.eval(d, x[i]) );
+        }
+        TEST_CASE("[Faunus] Grid")
+        {
+            auto f = [](double x){return 0.5*x*std::sin(x)+2;};
+            Andrea<double> andrea;
+            Grid<double> grid;
+            andrea.setTolerance(2e-4, 1e-2);
+            grid.setTolerance(2e-4, 1e-2);
+            auto d1 = andrea.generate(f, 0, 10);
+            auto d2 = grid.generate(f, 0, 10);
+
+            CHECK( d1.r2 == d2.r2 );
+            CHECK( d2.index.size() > 1 );
+            for (double x=1e-9; x<=10; x+=0.0123)
+                CHECK( grid.eval(d2, x) == andrea.eval(d1, x) );
+            for (double x : d1.r2) // exactly at knots
+                if (x > 0)
+                    CHECK( grid.eval(d2, x) == andrea.eval(d1, x) );
+
+            std::vector<double> x = {1e-9, 0.1, 2.5, 5, 7.77, 9.999, 10}, y(x.size());
+            grid.eval(d2, x.data(), y.data(), int(x.size()));
+            for (size_t i = 0; i < x.size(); i++)
+                CHECK( y[i] == andrea.eval(d1, x[i]) );
         }
 #endif
 
@@ -8,6 +8,7 @@
 #include "core.h"
 #include "mpi.h"
 #include "auxiliary.h"
+#include "fft.h"
 #include "molecule.h"
 #include "group.h"
 #include "geometry.h"